@@ -47,11 +47,37 @@ static const char *const atomNameArray[] = {
     NULL
 };
 
+#if !(defined(_WIN32) || defined(MAC_OSX_TK))
+/*
+ * Atoms that nearly every application interns while creating its first
+ * toplevel and using the selection. They are interned in one request when the
+ * atom cache of a display is initialized, instead of one round trip each.
+ */
+
+static const char *const prefetchAtomNames[] = {
+    "WM_PROTOCOLS",		"WM_DELETE_WINDOW",
+    "_NET_WM_PING",		"_NET_WM_PID",
+    "_NET_WM_NAME",		"_NET_WM_ICON_NAME",
+    "_NET_WM_STATE",		"_NET_WM_WINDOW_TYPE",
+    "UTF8_STRING",		"CLIPBOARD",
+    "TARGETS",			"MULTIPLE",
+    "INCR",			"TIMESTAMP",
+    "TEXT",			"COMPOUND_TEXT",
+    "ATOM_PAIR",		"TK_APPLICATION",
+    "TK_WINDOW",		"Comm",
+    "InterpRegistry"
+};
+#endif
+
 /*
  * Forward references to functions defined in this file:
  */
 
 static void	AtomInit(TkDisplay *dispPtr);
+static const char *CacheAtom(TkDisplay *dispPtr, const char *name,
+		    Atom atom);
+static void	InternAtoms(TkDisplay *dispPtr, int count,
+		    const char *const *names, Atom *atoms);
 
 /*
  *--------------------------------------------------------------
@@ -99,6 +125,40 @@ Tk_InternAtom(
     }
     return (Atom)PTR2INT(Tcl_GetHashValue(hPtr));
 }
+
+/*
+ *--------------------------------------------------------------
+ *
+ * Tk_InternAtoms --
+ *
+ *	Like Tk_InternAtom, but for several names at once. All the names that
+ *	aren't in the local cache yet are sent to the server in a single
+ *	request.
+ *
+ * Results:
+ *	The atoms corresponding to the names are stored in atoms.
+ *
+ * Side effects:
+ *	New entries may be added to the local atom cache.
+ *
+ *--------------------------------------------------------------
+ */
+
+void
+Tk_InternAtoms(
+    Tk_Window tkwin,		/* Window token; map names to atoms for this
+				 * window's display. */
+    int count,			/* Number of names. */
+    const char *const *names,	/* Names to turn into atoms. */
+    Atom *atoms)		/* Where to store the atoms, count entries. */
+{
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+
+    if (!dispPtr->atomInit) {
+	AtomInit(dispPtr);
+    }
+    InternAtoms(dispPtr, count, names, atoms);
+}
 
 /*
  *--------------------------------------------------------------
@@ -139,7 +199,6 @@ Tk_GetAtomName(
     if (hPtr == NULL) {
 	const char *name;
 	Tk_ErrorHandler handler;
-	int isNew;
 	char *mustFree = NULL;
 
 	handler = Tk_CreateErrorHandler(dispPtr->display, BadAtom, -1, -1,
@@ -149,17 +208,87 @@ Tk_GetAtomName(
 	    name = "?bad atom?";
 	}
 	Tk_DeleteErrorHandler(handler);
-	hPtr = Tcl_CreateHashEntry(&dispPtr->nameTable, name, &isNew);
-	Tcl_SetHashValue(hPtr, INT2PTR(atom));
+	name = CacheAtom(dispPtr, name, atom);
 	if (mustFree) {
 	    XFree(mustFree);
 	}
-	name = (const char *)Tcl_GetHashKey(&dispPtr->nameTable, hPtr);
-	hPtr = Tcl_CreateHashEntry(&dispPtr->atomTable, INT2PTR(atom), &isNew);
-	Tcl_SetHashValue(hPtr, (char *)name);
+	return name;
     }
     return (const char *)Tcl_GetHashValue(hPtr);
 }
+
+/*
+ *--------------------------------------------------------------
+ *
+ * TkCacheAtomNames --
+ *
+ *	Makes sure that the names of a list of atoms, typically found in a
+ *	window property or a selection reply, are in the local atom cache.
+ *	The names that aren't are fetched from the server with a single
+ *	request, so that the Tk_GetAtomName calls that follow don't need a
+ *	round trip each.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	New entries may be added to the local atom cache. Atoms that don't
+ *	exist are left to Tk_GetAtomName.
+ *
+ *--------------------------------------------------------------
+ */
+
+void
+TkCacheAtomNames(
+    Tk_Window tkwin,		/* Window token; atoms are relative to this
+				 * window's display. */
+    const Atom *atoms,		/* Atoms whose names will be wanted. */
+    int count)			/* Number of atoms. */
+{
+#if !(defined(_WIN32) || defined(MAC_OSX_TK))
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    Atom *missing;
+    char **names;
+    Tk_ErrorHandler handler;
+    int i, numMissing = 0;
+
+    if (!dispPtr->atomInit) {
+	AtomInit(dispPtr);
+    }
+    missing = (Atom *)ckalloc(count * sizeof(Atom));
+    for (i = 0; i < count; i++) {
+	if ((atoms[i] != None) && (Tcl_FindHashEntry(&dispPtr->atomTable,
+		INT2PTR(atoms[i])) == NULL)) {
+	    missing[numMissing++] = atoms[i];
+	}
+    }
+    if (numMissing > 1) {
+	/*
+	 * If some atom is bad, XGetAtomNames fails but the names it did get
+	 * are still returned.
+	 */
+
+	names = (char **)ckalloc(numMissing * sizeof(char *));
+	memset(names, 0, numMissing * sizeof(char *));
+	handler = Tk_CreateErrorHandler(dispPtr->display, BadAtom, -1, -1,
+		NULL, NULL);
+	(void) XGetAtomNames(dispPtr->display, missing, numMissing, names);
+	Tk_DeleteErrorHandler(handler);
+	for (i = 0; i < numMissing; i++) {
+	    if (names[i] != NULL) {
+		CacheAtom(dispPtr, names[i], missing[i]);
+		XFree(names[i]);
+	    }
+	}
+	ckfree(names);
+    }
+    ckfree(missing);
+#else
+    (void)tkwin;
+    (void)atoms;
+    (void)count;
+#endif
+}
 
 /*
  *--------------------------------------------------------------
@@ -189,21 +318,112 @@ AtomInit(
     Tcl_InitHashTable(&dispPtr->atomTable, TCL_ONE_WORD_KEYS);
 
     for (atom = 1; atom <= XA_LAST_PREDEFINED; atom++) {
-	const char *name;
-	int isNew;
-
 	hPtr = Tcl_FindHashEntry(&dispPtr->atomTable, INT2PTR(atom));
 	if (hPtr != NULL) {
 	    continue;
 	}
+	CacheAtom(dispPtr, atomNameArray[atom - 1], atom);
+    }
 
-	name = atomNameArray[atom - 1];
-	hPtr = Tcl_CreateHashEntry(&dispPtr->nameTable, name, &isNew);
-	Tcl_SetHashValue(hPtr, INT2PTR(atom));
-	name = (const char *)Tcl_GetHashKey(&dispPtr->nameTable, hPtr);
-	hPtr = Tcl_CreateHashEntry(&dispPtr->atomTable, INT2PTR(atom), &isNew);
-	Tcl_SetHashValue(hPtr, (char *)name);
+#if !(defined(_WIN32) || defined(MAC_OSX_TK))
+    InternAtoms(dispPtr, sizeof(prefetchAtomNames) / sizeof(char *),
+	    prefetchAtomNames, NULL);
+#endif
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * InternAtoms --
+ *
+ *	Interns a list of names on a display, sending all the names that
+ *	aren't in the local cache to the server in a single XInternAtoms
+ *	request where the platform has it.
+ *
+ * Results:
+ *	If atoms isn't NULL, the atoms corresponding to the names are stored
+ *	in it.
+ *
+ * Side effects:
+ *	New entries may be added to the local atom cache.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+InternAtoms(
+    TkDisplay *dispPtr,		/* Display, with its atom cache set up. */
+    int count,			/* Number of names. */
+    const char *const *names,	/* Names to turn into atoms. */
+    Atom *atoms)		/* Where to store the atoms, or NULL. */
+{
+    Tcl_HashEntry *hPtr;
+    char **missing;
+    Atom *missingAtoms;
+    int i, numMissing = 0;
+
+    missing = (char **)ckalloc(count * sizeof(char *));
+    missingAtoms = (Atom *)ckalloc(count * sizeof(Atom));
+    for (i = 0; i < count; i++) {
+	if (Tcl_FindHashEntry(&dispPtr->nameTable, names[i]) == NULL) {
+	    missing[numMissing++] = (char *) names[i];
+	}
+    }
+    if (numMissing > 0) {
+#if !(defined(_WIN32) || defined(MAC_OSX_TK))
+	XInternAtoms(dispPtr->display, missing, numMissing, False,
+		missingAtoms);
+#else
+	for (i = 0; i < numMissing; i++) {
+	    missingAtoms[i] = XInternAtom(dispPtr->display, missing[i], False);
+	}
+#endif
+	for (i = 0; i < numMissing; i++) {
+	    CacheAtom(dispPtr, missing[i], missingAtoms[i]);
+	}
     }
+    if (atoms != NULL) {
+	for (i = 0; i < count; i++) {
+	    hPtr = Tcl_FindHashEntry(&dispPtr->nameTable, names[i]);
+	    atoms[i] = (Atom)PTR2INT(Tcl_GetHashValue(hPtr));
+	}
+    }
+    ckfree(missingAtoms);
+    ckfree(missing);
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * CacheAtom --
+ *
+ *	Records a name and its atom in both directions of the atom cache of a
+ *	display.
+ *
+ * Results:
+ *	The copy of the name owned by the cache.
+ *
+ * Side effects:
+ *	Entries are added to the cache or replaced.
+ *
+ *--------------------------------------------------------------
+ */
+
+static const char *
+CacheAtom(
+    TkDisplay *dispPtr,		/* Display, with its atom cache set up. */
+    const char *name,		/* Name of the atom. */
+    Atom atom)			/* The atom. */
+{
+    Tcl_HashEntry *hPtr;
+    int isNew;
+
+    hPtr = Tcl_CreateHashEntry(&dispPtr->nameTable, name, &isNew);
+    Tcl_SetHashValue(hPtr, INT2PTR(atom));
+    name = (const char *)Tcl_GetHashKey(&dispPtr->nameTable, hPtr);
+    hPtr = Tcl_CreateHashEntry(&dispPtr->atomTable, INT2PTR(atom), &isNew);
+    Tcl_SetHashValue(hPtr, (char *)name);
+    return name;
 }
 
 /*
@@ -42,12 +42,21 @@ static int		InactiveCmd(ClientData dummy, Tcl_Interp *interp,
 			    int objc, Tcl_Obj *const *objv);
 static int		ScalingCmd(ClientData dummy, Tcl_Interp *interp,
 			    int objc, Tcl_Obj *const *objv);
+static int		StartupprofileCmd(ClientData dummy,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj *const *objv);
 static int		UseinputmethodsCmd(ClientData dummy,
 			    Tcl_Interp *interp, int objc,
 			    Tcl_Obj *const *objv);
 static int		WindowingsystemCmd(ClientData dummy,
 			    Tcl_Interp *interp, int objc,
 			    Tcl_Obj *const *objv);
+static int		WmsyncCmd(ClientData dummy,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj *const *objv);
+static int		WmwaitprofileCmd(ClientData dummy,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj *const *objv);
 
 #if defined(_WIN32) || defined(MAC_OSX_TK)
 MODULE_SCOPE const TkEnsemble tkFontchooserEnsemble[];
@@ -65,8 +74,11 @@ static const TkEnsemble tkCmdMap[] = {
     {"caret",		CaretCmd, NULL },
     {"inactive",	InactiveCmd, NULL },
     {"scaling",		ScalingCmd, NULL },
+    {"startupprofile",	StartupprofileCmd, NULL },
     {"useinputmethods",	UseinputmethodsCmd, NULL },
     {"windowingsystem",	WindowingsystemCmd, NULL },
+    {"wmsync",		WmsyncCmd, NULL },
+    {"wmwaitprofile",	WmwaitprofileCmd, NULL },
     {"fontchooser",	NULL, tkFontchooserEnsemble},
     {NULL, NULL, NULL}
 };
@@ -659,8 +671,8 @@ TkInitTkCmd(
 /*
  *----------------------------------------------------------------------
  *
- * AppnameCmd, CaretCmd, ScalingCmd, UseinputmethodsCmd,
- * WindowingsystemCmd, InactiveCmd --
+ * AppnameCmd, CaretCmd, ScalingCmd, StartupprofileCmd, UseinputmethodsCmd,
+ * WindowingsystemCmd, WmsyncCmd, WmwaitprofileCmd, InactiveCmd --
  *
  *	These functions are invoked to process the "tk" ensemble subcommands.
  *	See the user documentation for details on what they do.
@@ -895,6 +907,41 @@ UseinputmethodsCmd(
     return TCL_OK;
 }
 
+/*
+ * Names of the startup phases reported by [tk startupprofile]. The order
+ * must match the one of enum TkStartupPhase in tkInt.h.
+ */
+
+static const char *const startupPhaseNames[] = {
+    "display", "fonts", "options", "scripts", "total"
+};
+
+int
+StartupprofileCmd(
+    ClientData clientData,	/* Main window associated with interpreter. */
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    TkMainInfo *mainPtr = ((TkWindow *) clientData)->mainPtr;
+    Tcl_Obj *resultObj;
+    int i;
+
+    if (objc != 1) {
+	Tcl_WrongNumArgs(interp, 1, objv, NULL);
+	return TCL_ERROR;
+    }
+    resultObj = Tcl_NewObj();
+    for (i = 0; i < TK_STARTUP_PHASES; i++) {
+	Tcl_ListObjAppendElement(NULL, resultObj,
+		Tcl_NewStringObj(startupPhaseNames[i], -1));
+	Tcl_ListObjAppendElement(NULL, resultObj,
+		Tcl_NewDoubleObj(mainPtr->startupTimes[i] / 1000.0));
+    }
+    Tcl_SetObjResult(interp, resultObj);
+    return TCL_OK;
+}
+
 int
 WindowingsystemCmd(
     TCL_UNUSED(void *),	/* Main window associated with interpreter. */
@@ -919,6 +966,86 @@ WindowingsystemCmd(
     return TCL_OK;
 }
 
+int
+WmsyncCmd(
+    ClientData clientData,	/* Main window associated with interpreter. */
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    Tk_Window tkwin = (Tk_Window)clientData;
+    TkDisplay *dispPtr;
+    int skip;
+
+    skip = TkGetDisplayOf(interp, objc-1, objv+1, &tkwin);
+    if (skip < 0) {
+	return TCL_ERROR;
+    }
+    dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    if ((objc - skip) == 2) {
+	int boolVal;
+
+	if (Tcl_GetBooleanFromObj(interp, objv[1+skip],
+		&boolVal) != TCL_OK) {
+	    return TCL_ERROR;
+	}
+	if (boolVal) {
+	    dispPtr->flags &= ~TK_DISPLAY_WM_ASYNC;
+	} else {
+	    dispPtr->flags |= TK_DISPLAY_WM_ASYNC;
+	}
+    } else if ((objc - skip) != 1) {
+	Tcl_WrongNumArgs(interp, 1, objv,
+		"?-displayof window? ?boolean?");
+	return TCL_ERROR;
+    }
+    Tcl_SetObjResult(interp,
+	    Tcl_NewBooleanObj(!(dispPtr->flags & TK_DISPLAY_WM_ASYNC)));
+    return TCL_OK;
+}
+
+int
+WmwaitprofileCmd(
+    ClientData clientData,	/* Main window associated with interpreter. */
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    Tk_Window tkwin = (Tk_Window)clientData;
+    TkDisplay *dispPtr;
+    Tcl_Obj *resultObj;
+    int skip;
+
+    skip = TkGetDisplayOf(interp, objc-1, objv+1, &tkwin);
+    if (skip < 0) {
+	return TCL_ERROR;
+    }
+    if ((objc - skip) != 1) {
+	Tcl_WrongNumArgs(interp, 1, objv, "?-displayof window?");
+	return TCL_ERROR;
+    }
+    dispPtr = ((TkWindow *) tkwin)->dispPtr;
+
+    resultObj = Tcl_NewObj();
+    Tcl_ListObjAppendElement(NULL, resultObj, Tcl_NewStringObj("waits", -1));
+    Tcl_ListObjAppendElement(NULL, resultObj,
+	    Tcl_NewWideIntObj(dispPtr->wmWaitCount));
+    Tcl_ListObjAppendElement(NULL, resultObj,
+	    Tcl_NewStringObj("timeouts", -1));
+    Tcl_ListObjAppendElement(NULL, resultObj,
+	    Tcl_NewWideIntObj(dispPtr->wmWaitTimeouts));
+    Tcl_ListObjAppendElement(NULL, resultObj,
+	    Tcl_NewStringObj("totaltime", -1));
+    Tcl_ListObjAppendElement(NULL, resultObj,
+	    Tcl_NewDoubleObj(dispPtr->wmWaitTime / 1000.0));
+    Tcl_ListObjAppendElement(NULL, resultObj,
+	    Tcl_NewStringObj("maxtime", -1));
+    Tcl_ListObjAppendElement(NULL, resultObj,
+	    Tcl_NewDoubleObj(dispPtr->wmWaitMaxTime / 1000.0));
+    Tcl_SetObjResult(interp, resultObj);
+    return TCL_OK;
+}
+
 int
 InactiveCmd(
     ClientData clientData,	/* Main window associated with interpreter. */
@@ -893,6 +893,15 @@ EXTERN void		Tk_SendVirtualEvent(Tk_Window tkwin,
 				const char *eventName, Tcl_Obj *detail);
 /* 279 */
 EXTERN Tcl_Obj *	Tk_FontGetDescription(Tk_Font tkfont);
+/* 280 */
+EXTERN int		Tk_PhotoDecodeBlock(Tcl_Interp *interp,
+				Tcl_Obj *dataObj, Tcl_Obj *formatObj,
+				Tk_PhotoImageBlock *blockPtr);
+/* 281 */
+EXTERN void		Tk_PhotoFreeBlock(Tk_PhotoImageBlock *blockPtr);
+/* 282 */
+EXTERN void		Tk_InternAtoms(Tk_Window tkwin, int count,
+				const char *const *names, Atom *atoms);
 
 typedef struct {
     const struct TkPlatStubs *tkPlatStubs;
@@ -1185,6 +1194,9 @@ typedef struct TkStubs {
     Tcl_Obj * (*tk_NewWindowObj) (Tk_Window tkwin); /* 277 */
     void (*tk_SendVirtualEvent) (Tk_Window tkwin, const char *eventName, Tcl_Obj *detail); /* 278 */
     Tcl_Obj * (*tk_FontGetDescription) (Tk_Font tkfont); /* 279 */
+    int (*tk_PhotoDecodeBlock) (Tcl_Interp *interp, Tcl_Obj *dataObj, Tcl_Obj *formatObj, Tk_PhotoImageBlock *blockPtr); /* 280 */
+    void (*tk_PhotoFreeBlock) (Tk_PhotoImageBlock *blockPtr); /* 281 */
+    void (*tk_InternAtoms) (Tk_Window tkwin, int count, const char *const *names, Atom *atoms); /* 282 */
 } TkStubs;
 
 extern const TkStubs *tkStubsPtr;
@@ -1757,6 +1769,12 @@ extern const TkStubs *tkStubsPtr;
 	(tkStubsPtr->tk_SendVirtualEvent) /* 278 */
 #define Tk_FontGetDescription \
 	(tkStubsPtr->tk_FontGetDescription) /* 279 */
+#define Tk_PhotoDecodeBlock \
+	(tkStubsPtr->tk_PhotoDecodeBlock) /* 280 */
+#define Tk_PhotoFreeBlock \
+	(tkStubsPtr->tk_PhotoFreeBlock) /* 281 */
+#define Tk_InternAtoms \
+	(tkStubsPtr->tk_InternAtoms) /* 282 */
 
 #endif /* defined(USE_TK_STUBS) */
 
@@ -1978,21 +1978,19 @@ EntryComputeGeometry(
     Tk_FontMetrics fm;
     char *p;
 
-    if (entryPtr->displayString != entryPtr->string) {
-	ckfree((char *)entryPtr->displayString);
-	entryPtr->displayString = entryPtr->string;
-	entryPtr->numDisplayBytes = entryPtr->numBytes;
-    }
-
     /*
      * If we're displaying a special character instead of the value of the
-     * entry, recompute the displayString.
+     * entry, recompute the displayString. Since it consists of nothing but
+     * copies of that character, a masked string built for the same character
+     * is only grown or truncated, so that typing into a password field does
+     * not rebuild the whole string on every keystroke.
      */
 
     if (entryPtr->showChar != NULL) {
 	int ch;
 	char buf[6];
 	int size;
+	TkSizeT oldChars = 0;
 
 	/*
 	 * Normalize the special character so we can safely duplicate it in
@@ -2004,15 +2002,34 @@ EntryComputeGeometry(
 	TkUtfToUniChar(entryPtr->showChar, &ch);
 	size = TkUniCharToUtf(ch, buf);
 
+	if (entryPtr->displayString == entryPtr->string) {
+	    p = NULL;
+	} else {
+	    p = (char *)entryPtr->displayString;
+	    if ((entryPtr->numDisplayBytes > 0)
+		    && (entryPtr->numDisplayBytes % size == 0)
+		    && memcmp(p, buf, size) == 0) {
+		oldChars = entryPtr->numDisplayBytes / size;
+	    }
+	}
+	if (oldChars > entryPtr->numChars) {
+	    oldChars = entryPtr->numChars;
+	}
+
 	entryPtr->numDisplayBytes = entryPtr->numChars * size;
-	p = (char *)ckalloc(entryPtr->numDisplayBytes + 1);
+	p = (char *)ckrealloc(p, entryPtr->numDisplayBytes + 1);
 	entryPtr->displayString = p;
 
-	for (i = entryPtr->numChars; i-- > 0; ) {
+	p += oldChars * size;
+	for (i = entryPtr->numChars - oldChars; i-- > 0; ) {
 	    memcpy(p, buf, size);
 	    p += size;
 	}
 	*p = '\0';
+    } else if (entryPtr->displayString != entryPtr->string) {
+	ckfree((char *)entryPtr->displayString);
+	entryPtr->displayString = entryPtr->string;
+	entryPtr->numDisplayBytes = entryPtr->numBytes;
     }
 
     /* Recompute layout of placeholder text.
@@ -2020,8 +2037,18 @@ EntryComputeGeometry(
      * We use the same font so we can use the layoutY value from below.
      */
 
-    Tk_FreeTextLayout(entryPtr->placeholderLayout);
-    if (entryPtr->placeholderString) {
+    /*
+     * The placeholder is only drawn while the entry is empty, so there is no
+     * point in laying it out again on every edit of a non-empty entry. The
+     * next time the entry becomes empty this function gets called anyway.
+     */
+
+    if (entryPtr->numChars != 0) {
+	Tk_FreeTextLayout(entryPtr->placeholderLayout);
+	entryPtr->placeholderLayout = NULL;
+	entryPtr->placeholderChars = 0;
+    } else if (entryPtr->placeholderString) {
+	Tk_FreeTextLayout(entryPtr->placeholderLayout);
         entryPtr->placeholderChars = strlen(entryPtr->placeholderString);
         entryPtr->placeholderLayout = Tk_ComputeTextLayout(entryPtr->tkfont,
 	        entryPtr->placeholderString, entryPtr->placeholderChars, 0,
@@ -2060,6 +2087,7 @@ EntryComputeGeometry(
 	    entryPtr->placeholderX = entryPtr->inset -rightX;
         }
     } else {
+	Tk_FreeTextLayout(entryPtr->placeholderLayout);
         entryPtr->placeholderChars = 0;
         entryPtr->placeholderLayout = Tk_ComputeTextLayout(entryPtr->tkfont,
 	        entryPtr->placeholderString, 0, 0,
@@ -2279,20 +2307,27 @@ DeleteChars(
     memcpy(newStr, string, (size_t) byteIndex);
     strcpy(newStr + byteIndex, string + byteIndex + byteCount);
 
-    toDelete = (char *)ckalloc(byteCount + 1);
-    memcpy(toDelete, string + byteIndex, (size_t) byteCount);
-    toDelete[byteCount] = '\0';
+    /*
+     * The deleted characters are only needed as %S in the validation script,
+     * so don't bother copying them out unless validation is going to run.
+     */
 
     if ((entryPtr->validate == VALIDATE_KEY ||
-	    entryPtr->validate == VALIDATE_ALL) &&
-	    EntryValidateChange(entryPtr, toDelete, newStr, index,
-		    VALIDATE_DELETE) != TCL_OK) {
-	ckfree(newStr);
+	    entryPtr->validate == VALIDATE_ALL)) {
+	int code;
+
+	toDelete = (char *)ckalloc(byteCount + 1);
+	memcpy(toDelete, string + byteIndex, (size_t) byteCount);
+	toDelete[byteCount] = '\0';
+	code = EntryValidateChange(entryPtr, toDelete, newStr, index,
+		VALIDATE_DELETE);
 	ckfree(toDelete);
-	return TCL_OK;
+	if (code != TCL_OK) {
+	    ckfree(newStr);
+	    return TCL_OK;
+	}
     }
 
-    ckfree(toDelete);
     ckfree((char *)entryPtr->string);
     entryPtr->string = newStr;
     entryPtr->numChars -= count;
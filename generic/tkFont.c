@@ -18,15 +18,11 @@
 #endif
 
 /*
- * The following structure is used to keep track of all the fonts that exist
- * in the current application. It must be stored in the TkMainInfo for the
- * application.
+ * The following structure is used to keep track of the named fonts of an
+ * application. It must be stored in the TkMainInfo for the application.
  */
 
 typedef struct TkFontInfo {
-    Tcl_HashTable fontCache;	/* Map a string to an existing Tk_Font. Keys
-				 * are string font names, values are TkFont
-				 * pointers. */
     Tcl_HashTable namedTable;	/* Map a name to a set of attributes for a
 				 * font, used when constructing a Tk_Font from
 				 * a named font description. Keys are strings,
@@ -37,6 +33,23 @@ typedef struct TkFontInfo {
 				 * named font. */
 } TkFontInfo;
 
+/*
+ * The cache mapping font names to existing fonts is shared by all the
+ * applications of a thread, so that interpreters using the same font on the
+ * same screen share a single TkFont. Fonts derived from a named font remain
+ * private to the application owning the named font: they are told apart by
+ * their namedHashPtr, which points into that application's namedTable.
+ */
+
+typedef struct {
+    Tcl_HashTable fontCache;	/* Map a string to an existing Tk_Font. Keys
+				 * are string font names, values are TkFont
+				 * pointers. */
+    int numApps;		/* Number of applications using fontCache; it
+				 * is deleted when this drops to zero. */
+} ThreadSpecificData;
+static Tcl_ThreadDataKey dataKey;
+
 /*
  * The following data structure is used to keep track of the font attributes
  * for each named font that has been defined. The named font is only deleted
@@ -380,9 +393,13 @@ void
 TkFontPkgInit(
     TkMainInfo *mainPtr)	/* The application being created. */
 {
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
     TkFontInfo *fiPtr = (TkFontInfo *)ckalloc(sizeof(TkFontInfo));
 
-    Tcl_InitHashTable(&fiPtr->fontCache, TCL_STRING_KEYS);
+    if (tsdPtr->numApps++ == 0) {
+	Tcl_InitHashTable(&tsdPtr->fontCache, TCL_STRING_KEYS);
+    }
     Tcl_InitHashTable(&fiPtr->namedTable, TCL_STRING_KEYS);
     fiPtr->mainPtr = mainPtr;
     fiPtr->updatePending = 0;
@@ -413,28 +430,37 @@ void
 TkFontPkgFree(
     TkMainInfo *mainPtr)	/* The application being deleted. */
 {
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
     TkFontInfo *fiPtr = mainPtr->fontInfoPtr;
     Tcl_HashEntry *hPtr, *searchPtr;
     Tcl_HashSearch search;
     int fontsLeft = 0;
 
-    for (searchPtr = Tcl_FirstHashEntry(&fiPtr->fontCache, &search);
-	    searchPtr != NULL;
-	    searchPtr = Tcl_NextHashEntry(&search)) {
-	fontsLeft++;
+    /*
+     * Other applications may still be using the fonts in the cache; it goes
+     * away with the last application of the thread.
+     */
+
+    if (--tsdPtr->numApps == 0) {
+	for (searchPtr = Tcl_FirstHashEntry(&tsdPtr->fontCache, &search);
+		searchPtr != NULL;
+		searchPtr = Tcl_NextHashEntry(&search)) {
+	    fontsLeft++;
 #ifdef DEBUG_FONTS
-	fprintf(stderr, "Font %s still in cache.\n",
-		(char *) Tcl_GetHashKey(&fiPtr->fontCache, searchPtr));
+	    fprintf(stderr, "Font %s still in cache.\n",
+		    (char *) Tcl_GetHashKey(&tsdPtr->fontCache, searchPtr));
 #endif
-    }
+	}
 
 #ifdef PURIFY
-    if (fontsLeft) {
-	Tcl_Panic("TkFontPkgFree: all fonts should have been freed already");
-    }
+	if (fontsLeft) {
+	    Tcl_Panic("TkFontPkgFree: all fonts should have been freed already");
+	}
 #endif
 
-    Tcl_DeleteHashTable(&fiPtr->fontCache);
+	Tcl_DeleteHashTable(&tsdPtr->fontCache);
+    }
 
     hPtr = Tcl_FirstHashEntry(&fiPtr->namedTable, &search);
     while (hPtr != NULL) {
@@ -841,6 +867,8 @@ UpdateDependentFonts(
     Tk_Window tkwin,		/* A window in the application. */
     Tcl_HashEntry *namedHashPtr)/* The named font that is changing. */
 {
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
     Tcl_HashEntry *cacheHashPtr;
     Tcl_HashSearch search;
     TkFont *fontPtr;
@@ -855,7 +883,7 @@ UpdateDependentFonts(
 	return;
     }
 
-    cacheHashPtr = Tcl_FirstHashEntry(&fiPtr->fontCache, &search);
+    cacheHashPtr = Tcl_FirstHashEntry(&tsdPtr->fontCache, &search);
     while (cacheHashPtr != NULL) {
 	for (fontPtr = (TkFont *)Tcl_GetHashValue(cacheHashPtr);
 		fontPtr != NULL; fontPtr = fontPtr->nextPtr) {
@@ -1104,6 +1132,8 @@ Tk_AllocFontFromObj(
     Tcl_Obj *objPtr)		/* Object describing font, as: named font,
 				 * native format, or parseable string. */
 {
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
     TkFontInfo *fiPtr = ((TkWindow *) tkwin)->mainPtr->fontInfoPtr;
     Tcl_HashEntry *cacheHashPtr, *namedHashPtr;
     TkFont *fontPtr, *firstFontPtr, *oldFontPtr;
@@ -1133,7 +1163,9 @@ Tk_AllocFontFromObj(
 
     /*
      * Next, search the list of fonts that have the name we want, to see if
-     * one of them is for the right screen.
+     * one of them is for the right screen. The list is shared with other
+     * applications, so also check that the font is based on this
+     * application's named font, if the name is one.
      */
 
     isNew = 0;
@@ -1141,13 +1173,16 @@ Tk_AllocFontFromObj(
 	cacheHashPtr = oldFontPtr->cacheHashPtr;
 	FreeFontObj(objPtr);
     } else {
-	cacheHashPtr = Tcl_CreateHashEntry(&fiPtr->fontCache,
+	cacheHashPtr = Tcl_CreateHashEntry(&tsdPtr->fontCache,
 		Tcl_GetString(objPtr), &isNew);
     }
+    namedHashPtr = Tcl_FindHashEntry(&fiPtr->namedTable,
+	    Tcl_GetString(objPtr));
     firstFontPtr = (TkFont *)Tcl_GetHashValue(cacheHashPtr);
     for (fontPtr = firstFontPtr; (fontPtr != NULL);
 	    fontPtr = fontPtr->nextPtr) {
-	if (Tk_Screen(tkwin) == fontPtr->screen) {
+	if ((Tk_Screen(tkwin) == fontPtr->screen)
+		&& (fontPtr->namedHashPtr == namedHashPtr)) {
 	    fontPtr->resourceRefCount++;
 	    fontPtr->objRefCount++;
 	    objPtr->internalRep.twoPtrValue.ptr1 = fontPtr;
@@ -1160,8 +1195,6 @@ Tk_AllocFontFromObj(
      * The desired font isn't in the table. Make a new one.
      */
 
-    namedHashPtr = Tcl_FindHashEntry(&fiPtr->namedTable,
-	    Tcl_GetString(objPtr));
     if (namedHashPtr != NULL) {
 	/*
 	 * Construct a font based on a named font.
@@ -1291,9 +1324,11 @@ Tk_GetFontFromObj(
 				 * in. */
     Tcl_Obj *objPtr)		/* The object from which to get the font. */
 {
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
     TkFontInfo *fiPtr = ((TkWindow *) tkwin)->mainPtr->fontInfoPtr;
     TkFont *fontPtr;
-    Tcl_HashEntry *hashPtr;
+    Tcl_HashEntry *hashPtr, *namedHashPtr;
 
     if (objPtr->typePtr != &tkFontObjType
 	    || objPtr->internalRep.twoPtrValue.ptr2 != fiPtr) {
@@ -1324,12 +1359,16 @@ Tk_GetFontFromObj(
 	hashPtr = fontPtr->cacheHashPtr;
 	FreeFontObj(objPtr);
     } else {
-	hashPtr = Tcl_FindHashEntry(&fiPtr->fontCache, Tcl_GetString(objPtr));
+	hashPtr = Tcl_FindHashEntry(&tsdPtr->fontCache,
+		Tcl_GetString(objPtr));
     }
     if (hashPtr != NULL) {
+	namedHashPtr = Tcl_FindHashEntry(&fiPtr->namedTable,
+		Tcl_GetString(objPtr));
 	for (fontPtr = (TkFont *)Tcl_GetHashValue(hashPtr); fontPtr != NULL;
 		fontPtr = fontPtr->nextPtr) {
-	    if (Tk_Screen(tkwin) == fontPtr->screen) {
+	    if ((Tk_Screen(tkwin) == fontPtr->screen)
+		    && (fontPtr->namedHashPtr == namedHashPtr)) {
 		fontPtr->objRefCount++;
 		objPtr->internalRep.twoPtrValue.ptr1 = fontPtr;
 		objPtr->internalRep.twoPtrValue.ptr2 = fiPtr;
@@ -4277,17 +4316,18 @@ TkFontGetSymbolClass(void)
 
 Tcl_Obj *
 TkDebugFont(
-    Tk_Window tkwin,		/* The window in which the font will be used
+    TCL_UNUSED(Tk_Window),	/* The window in which the font will be used
 				 * (not currently used). */
     const char *name)		/* Name of the desired color. */
 {
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
     TkFont *fontPtr;
     Tcl_HashEntry *hashPtr;
     Tcl_Obj *resultPtr, *objPtr;
 
     resultPtr = Tcl_NewObj();
-    hashPtr = Tcl_FindHashEntry(
-	    &((TkWindow *) tkwin)->mainPtr->fontInfoPtr->fontCache, name);
+    hashPtr = Tcl_FindHashEntry(&tsdPtr->fontCache, name);
     if (hashPtr != NULL) {
 	fontPtr = (TkFont *)Tcl_GetHashValue(hashPtr);
 	if (fontPtr == NULL) {
@@ -101,6 +101,14 @@ typedef struct {
 				 * Tk_GetImage, or NULL if bgimgPtr is
 				 * NULL. */
     int tile;			/* Whether to tile the bgimg. */
+    Pixmap bgTile;		/* bgimg drawn over the background colour and
+				 * repeated to cover BG_TILE_MIN pixels, or the
+				 * frame's interior if that is smaller, in
+				 * each direction; used to paint tiled
+				 * backgrounds with a few copies. None means
+				 * it must be (re)built before use. */
+    int bgTileWidth, bgTileHeight;
+				/* Size of bgTile. */
 #ifndef TK_NO_DOUBLE_BUFFERING
     GC copyGC;			/* GC for copying when double-buffering. */
 #endif /* TK_NO_DOUBLE_BUFFERING */
@@ -147,6 +155,15 @@ typedef struct {
 #define LABELSPACING 1
 #define LABELMARGIN 4
 
+/*
+ * Minimum size of the cached tile used to paint a tiled -backgroundimage.
+ * Small images are repeated within the tile up to this size so that a
+ * background needs only a few copies to paint, but never further than
+ * needed to cover the interior of the frame.
+ */
+
+#define BG_TILE_MIN 256
+
 /*
  * Flag bits for frames:
  *
@@ -335,13 +352,13 @@ static int		CreateFrame(ClientData clientData, Tcl_Interp *interp,
 static void		DestroyFrame(void *memPtr);
 static void		DestroyFramePartly(Frame *framePtr);
 static void		DisplayFrame(ClientData clientData);
-static void		DrawFrameBackground(Tk_Window tkwin, Pixmap pixmap,
-			    int highlightWidth, int borderWidth,
-			    Tk_Image bgimg, int bgtile);
+static void		DrawFrameBackground(Frame *framePtr, Pixmap pixmap,
+			    int highlightWidth, int borderWidth);
 static void		FrameBgImageProc(ClientData clientData,
 			    int x, int y, int width, int height,
 			    int imgWidth, int imgHeight);
 static void		FrameCmdDeletedProc(ClientData clientData);
+static void		FreeFrameBgTile(Frame *framePtr);
 static void		FrameEventProc(ClientData clientData,
 			    XEvent *eventPtr);
 static void		FrameLostContentProc(ClientData clientData,
@@ -950,6 +967,7 @@ DestroyFramePartly(
 	labelframePtr->labelWin = NULL;
     }
 
+    FreeFrameBgTile(framePtr);
     Tk_FreeConfigOptions((char *) framePtr, framePtr->optionTable,
 	    framePtr->tkwin);
 }
@@ -1165,6 +1183,13 @@ FrameWorldChanged(
     anyWindowLabel = (framePtr->type == TYPE_LABELFRAME) &&
 	    (labelframePtr->labelWin != NULL);
 
+    /*
+     * The background colour or image may have changed, so the cached
+     * background tile can't be trusted any more.
+     */
+
+    FreeFrameBgTile(framePtr);
+
 #ifndef TK_NO_DOUBLE_BUFFERING
     gcValues.graphics_exposures = False;
     gc = Tk_GetGC(tkwin, GCGraphicsExposures, &gcValues);
@@ -1542,8 +1567,8 @@ DisplayFrame(
 	TkpDrawFrameEx(tkwin, pixmap, framePtr->border, hlWidth,
 		framePtr->borderWidth, framePtr->relief);
 	if (framePtr->bgimg) {
-	    DrawFrameBackground(tkwin, pixmap, hlWidth, framePtr->borderWidth,
-		    framePtr->bgimg, framePtr->tile);
+	    DrawFrameBackground(framePtr, pixmap, hlWidth,
+		    framePtr->borderWidth);
 	}
     } else {
 	Labelframe *labelframePtr = (Labelframe *) framePtr;
@@ -2168,6 +2193,8 @@ FrameBgImageProc(
     (void)imgHeight;
 
 
+    FreeFrameBgTile(framePtr);
+
     /*
      * Changing the background image never alters the dimensions of the frame.
      */
@@ -2179,31 +2206,62 @@ FrameBgImageProc(
     }
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * FreeFrameBgTile --
+ *
+ *	Discard the cached background tile of a frame, so that it is rebuilt
+ *	the next time a tiled background image is drawn.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The tile pixmap, if any, is freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+FreeFrameBgTile(
+    Frame *framePtr)
+{
+    if (framePtr->bgTile != None) {
+	Tk_FreePixmap(framePtr->display, framePtr->bgTile);
+	framePtr->bgTile = None;
+    }
+}
+
 /*
  *----------------------------------------------------------------------
  *
  * DrawFrameBackground --
  *
  *	This function draws the background image of a rectangular frame area.
+ *	A tiled image is first rendered over the background colour into a
+ *	tile pixmap kept in the frame, which is then copied across the area;
+ *	the image itself is only redrawn when the tile has been invalidated
+ *	by a change of the image or the frame's colours.
  *
  * Results:
  *	None.
  *
  * Side effects:
- *	Draws inside the tkwin area.
+ *	Draws inside the tkwin area. May (re)build framePtr->bgTile.
  *
  *----------------------------------------------------------------------
  */
 
 static void
 DrawFrameBackground(
-    Tk_Window tkwin,
+    Frame *framePtr,
     Pixmap pixmap,
     int highlightWidth,
-    int borderWidth,
-    Tk_Image bgimg,
-    int bgtile)
+    int borderWidth)
 {
+    Tk_Window tkwin = framePtr->tkwin;
+    Tk_Image bgimg = framePtr->bgimg;
     int width, height;			/* Area to paint on. */
     int imageWidth, imageHeight;	/* Dimensions of image. */
     const int bw = highlightWidth + borderWidth;
@@ -2211,27 +2269,83 @@ DrawFrameBackground(
     Tk_SizeOfImage(bgimg, &imageWidth, &imageHeight);
     width = Tk_Width(tkwin) - 2*bw;
     height = Tk_Height(tkwin) - 2*bw;
+    if (imageWidth <= 0 || imageHeight <= 0 || width <= 0 || height <= 0) {
+	return;
+    }
 
-    if (bgtile) {
+    if (framePtr->tile) {
 	/*
 	 * Draw the image tiled in the widget (inside the border).
 	 */
 
-	int x, y;
+	XGCValues gcValues;
+	GC gc;
+	int x, y, done, n, tileWidth, tileHeight;
+
+	gcValues.graphics_exposures = False;
+	gc = Tk_GetGC(tkwin, GCGraphicsExposures, &gcValues);
+
+	/*
+	 * The tile holds whole copies of the image, enough to cover
+	 * BG_TILE_MIN pixels or the interior, whichever is smaller. A tile
+	 * built while the frame was smaller is rebuilt when it grows.
+	 */
+
+	tileWidth = (width < BG_TILE_MIN) ? width : BG_TILE_MIN;
+	tileWidth = ((tileWidth + imageWidth - 1) / imageWidth) * imageWidth;
+	tileHeight = (height < BG_TILE_MIN) ? height : BG_TILE_MIN;
+	tileHeight = ((tileHeight + imageHeight - 1) / imageHeight)
+		* imageHeight;
+	if ((framePtr->bgTile != None) && ((framePtr->bgTileWidth < tileWidth)
+		|| (framePtr->bgTileHeight < tileHeight))) {
+	    FreeFrameBgTile(framePtr);
+	}
+
+	if (framePtr->bgTile == None) {
+	    /*
+	     * Render the image once over the background colour, then double
+	     * it up within the tile until the tile is full.
+	     */
+
+	    framePtr->bgTileWidth = tileWidth;
+	    framePtr->bgTileHeight = tileHeight;
+	    framePtr->bgTile = Tk_GetPixmap(framePtr->display,
+		    Tk_WindowId(tkwin), framePtr->bgTileWidth,
+		    framePtr->bgTileHeight, Tk_Depth(tkwin));
+	    Tk_Fill3DRectangle(tkwin, framePtr->bgTile, framePtr->border, 0, 0,
+		    imageWidth, imageHeight, 0, TK_RELIEF_FLAT);
+	    Tk_RedrawImage(bgimg, 0, 0, imageWidth, imageHeight,
+		    framePtr->bgTile, 0, 0);
+	    for (done = imageWidth; done < framePtr->bgTileWidth;
+		    done *= 2) {
+		XCopyArea(framePtr->display, framePtr->bgTile,
+			framePtr->bgTile, gc, 0, 0, (unsigned) done,
+			(unsigned) imageHeight, done, 0);
+	    }
+	    for (done = imageHeight; done < framePtr->bgTileHeight;
+		    done *= 2) {
+		XCopyArea(framePtr->display, framePtr->bgTile,
+			framePtr->bgTile, gc, 0, 0,
+			(unsigned) framePtr->bgTileWidth, (unsigned) done,
+			0, done);
+	    }
+	}
 
-	for (x = bw; x - bw < width; x += imageWidth) {
-	    int w = imageWidth;
-	    if (x - bw + imageWidth > width) {
-		w = (width + bw) - x;
+	for (x = 0; x < width; x += framePtr->bgTileWidth) {
+	    n = framePtr->bgTileWidth;
+	    if (x + n > width) {
+		n = width - x;
 	    }
-	    for (y = bw; y < height + bw; y += imageHeight) {
-		int h = imageHeight;
-		if (y - bw + imageHeight > height) {
-		    h = (height + bw) - y;
+	    for (y = 0; y < height; y += framePtr->bgTileHeight) {
+		done = framePtr->bgTileHeight;
+		if (y + done > height) {
+		    done = height - y;
 		}
-		Tk_RedrawImage(bgimg, 0, 0, w, h, pixmap, x, y);
+		XCopyArea(framePtr->display, framePtr->bgTile, pixmap, gc,
+			0, 0, (unsigned) n, (unsigned) done, bw + x, bw + y);
 	    }
 	}
+	Tk_FreeGC(framePtr->display, gc);
     } else {
 	/*
 	 * Draw the image centred in the widget (inside the border).
@@ -2260,7 +2374,7 @@ DrawFrameBackground(
 	Tk_RedrawImage(bgimg, x, y, w, h, pixmap, xOff, yOff);
     }
 }
-
+
 /*
  * Local Variables:
  * mode: c
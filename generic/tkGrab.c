@@ -134,6 +134,14 @@ typedef struct NewGrabWinEvent {
 
 #define GENERATED_GRAB_EVENT_MAGIC ((Bool) 0x147321ac)
 
+/*
+ * Slot of dispPtr->grabCache used for a window. The low bits of a window
+ * address are always the same, so they are dropped.
+ */
+
+#define GRAB_CACHE_INDEX(winPtr) \
+    ((((size_t) (winPtr)) >> 5) % TK_GRAB_CACHE_SIZE)
+
 /*
  * Forward declarations for functions declared later in this file:
  */
@@ -1235,6 +1243,16 @@ TkGrabDeadWindow(
     }
     if (dispPtr->grabWinPtr == winPtr) {
 	dispPtr->grabWinPtr = NULL;
+	TkGrabTreeChanged(dispPtr);
+    }
+
+    /*
+     * Forget any cached grab state, so that a window later allocated at the
+     * same address doesn't inherit it.
+     */
+
+    if (dispPtr->grabCache[GRAB_CACHE_INDEX(winPtr)].winPtr == winPtr) {
+	dispPtr->grabCache[GRAB_CACHE_INDEX(winPtr)].winPtr = NULL;
     }
 }
 
@@ -1403,6 +1421,7 @@ GrabWinEventProc(
 
     grabEvPtr->dispPtr->grabWinPtr = (TkWindow *) Tk_IdToWindow(
 	    grabEvPtr->dispPtr->display, grabEvPtr->grabWindow);
+    TkGrabTreeChanged(grabEvPtr->dispPtr);
     return 1;
 }
 
@@ -1582,17 +1601,59 @@ TkGrabState(
     TkWindow *winPtr)		/* Window for which grab information is
 				 * needed. */
 {
-    TkWindow *grabWinPtr = winPtr->dispPtr->grabWinPtr;
+    TkDisplay *dispPtr = winPtr->dispPtr;
+    TkWindow *grabWinPtr = dispPtr->grabWinPtr;
+    TkGrabCacheEntry *cachePtr;
 
     if (grabWinPtr == NULL) {
 	return TK_GRAB_NONE;
     }
     if ((winPtr->mainPtr != grabWinPtr->mainPtr)
-	    && !(winPtr->dispPtr->grabFlags & GRAB_GLOBAL)) {
+	    && !(dispPtr->grabFlags & GRAB_GLOBAL)) {
 	return TK_GRAB_NONE;
     }
 
-    return TkPositionInTree(winPtr, grabWinPtr);
+    /*
+     * This gets called for every pointer event, so remember the position
+     * of the last few windows relative to the grab tree rather than walking
+     * the ancestor chain each time. TkGrabTreeChanged invalidates the cache.
+     */
+
+    cachePtr = &dispPtr->grabCache[GRAB_CACHE_INDEX(winPtr)];
+    if (cachePtr->winPtr != winPtr
+	    || cachePtr->epoch != dispPtr->grabEpoch) {
+	cachePtr->winPtr = winPtr;
+	cachePtr->epoch = dispPtr->grabEpoch;
+	cachePtr->state = TkPositionInTree(winPtr, grabWinPtr);
+    }
+    return cachePtr->state;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkGrabTreeChanged --
+ *
+ *	Invalidates the grab state cached by TkGrabState for all windows of
+ *	a display. Must be called whenever the grab window changes or a window
+ *	becomes or stops being a toplevel.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The next TkGrabState call for each window recomputes its state.
+ *
+ *----------------------------------------------------------------------
+ */
+
+void
+TkGrabTreeChanged(
+    TkDisplay *dispPtr)		/* Display whose grab state changed. */
+{
+    if (++dispPtr->grabEpoch == 0) {
+	dispPtr->grabEpoch = 1;
+    }
 }
 
 /*
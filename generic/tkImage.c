@@ -64,6 +64,10 @@ typedef struct ImageModel {
     int deleted;		/* Flag set when image is being deleted. */
     TkWindow *winPtr;		/* Main window of interpreter (used to detect
 				 * when the world is falling apart.) */
+    unsigned long changeStamp;	/* Stamp taken from the per-thread counter
+				 * whenever the image is (re)created or
+				 * changed. Lets callers cache data derived
+				 * from the image contents. */
 } ImageModel;
 
 typedef struct {
@@ -74,6 +78,10 @@ typedef struct {
 				 * image types. */
     int initialized;		/* Set to 1 if we've initialized the
 				 * structure. */
+    unsigned long changeStamp;	/* Last stamp handed out to an image model.
+				 * Never reused, so a (model, stamp) pair
+				 * stays unique even if a model's memory is
+				 * recycled. */
 } ThreadSpecificData;
 static Tcl_ThreadDataKey dataKey;
 
@@ -83,6 +91,7 @@ static Tcl_ThreadDataKey dataKey;
 
 static void		ImageTypeThreadExitProc(ClientData clientData);
 static void		DeleteImage(ImageModel *modelPtr);
+static unsigned long	NextChangeStamp(void);
 static void		EventuallyDeleteImage(ImageModel *modelPtr,
 			    int forgetImageHashNow);
 
@@ -327,6 +336,7 @@ Tk_ImageObjCmd(
 	    modelPtr->instancePtr = NULL;
 	    modelPtr->deleted = 0;
 	    modelPtr->winPtr = winPtr->mainPtr->winPtr;
+	    modelPtr->changeStamp = 0;
 	    Tcl_Preserve(modelPtr->winPtr);
 	    Tcl_SetHashValue(hPtr, modelPtr);
 	} else {
@@ -378,6 +388,7 @@ Tk_ImageObjCmd(
 	    return TCL_ERROR;
 	}
 	Tcl_Release(modelPtr);
+	modelPtr->changeStamp = NextChangeStamp();
 	if (oldimage) {
 	    ckfree(args);
 	}
@@ -537,6 +548,7 @@ Tk_ImageChanged(
 
     modelPtr->width = imageWidth;
     modelPtr->height = imageHeight;
+    modelPtr->changeStamp = NextChangeStamp();
     for (imagePtr = modelPtr->instancePtr; imagePtr != NULL;
 	    imagePtr = imagePtr->nextPtr) {
 	imagePtr->changeProc(imagePtr->widgetClientData, x, y, width, height,
@@ -1095,6 +1107,61 @@ Tk_GetImageModelData(
     return modelPtr->modelData;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * NextChangeStamp --
+ *
+ *	Hand out the next value of the per-thread image change counter.
+ *
+ * Results:
+ *	A stamp that has not been returned before in this thread (zero is
+ *	never returned).
+ *
+ * Side effects:
+ *	Advances the counter.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static unsigned long
+NextChangeStamp(void)
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+
+    if (++tsdPtr->changeStamp == 0) {
+	tsdPtr->changeStamp = 1;
+    }
+    return tsdPtr->changeStamp;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkGetImageChangeStamp --
+ *
+ *	Return a value that changes whenever the image is recreated or its
+ *	contents or size change (i.e. whenever Tk_ImageChanged is called for
+ *	it). Callers can use it to decide whether data derived from the image
+ *	is still valid.
+ *
+ * Results:
+ *	The image's current change stamp.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+unsigned long
+TkGetImageChangeStamp(
+    Tk_ImageModel imageModel)	/* Token for image model. */
+{
+    return ((ImageModel *) imageModel)->changeStamp;
+}
+
 /*
  *----------------------------------------------------------------------
  *
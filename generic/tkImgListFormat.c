@@ -76,6 +76,12 @@ static const char *const colorFormatNames[] = {
     NULL
 };
 
+/*
+ * Digits used when generating the #RRGGBB and #RRGGBBAA color formats.
+ */
+
+static const char hexDigits[] = "0123456789abcdef";
+
 /*
  * The following data structure is used to return information from
  * ParseFormatOptions:
@@ -130,15 +136,15 @@ static int      StringWriteDef(Tcl_Interp *interp,
                     Tcl_Obj *formatString,
                     Tk_PhotoImageBlock *blockPtr);
 static int      ParseColor(Tcl_Interp *interp, Tcl_Obj *specObj,
-                    Display *display, Colormap colormap, unsigned char *redPtr,
+                    Display *display, Colormap colormap,
+                    Tcl_HashTable *cachePtr, unsigned char *redPtr,
                     unsigned char *greenPtr, unsigned char *bluePtr,
                     unsigned char *alphaPtr);
 static int      ParseColorAsList(Tcl_Interp *interp, const char *colorString,
                     int colorStrLen, unsigned char *redPtr,
                     unsigned char *greenPtr, unsigned char *bluePtr,
                     unsigned char *alphaPtr);
-static int      ParseColorAsHex(Tcl_Interp *interp, const char *colorString,
-                    int colorStrLen, Display *display, Colormap colormap,
+static int      ParseColorAsHex(const char *colorString, int colorStrLen,
                     unsigned char *redPtr, unsigned char *greenPtr,
                     unsigned char *bluePtr, unsigned char *alphaPtr);
 static int      ParseColorAsStandard(Tcl_Interp *interp,
@@ -417,8 +423,8 @@ StringMatchDef(
         return 0;
     }
     if (ParseColor(interp, pixelData, Tk_Display(Tk_MainWindow(interp)),
-            Tk_Colormap(Tk_MainWindow(interp)), &dummy, &dummy, &dummy, &dummy)
-            != TCL_OK) {
+            Tk_Colormap(Tk_MainWindow(interp)), NULL,
+            &dummy, &dummy, &dummy, &dummy) != TCL_OK) {
         return 0;
     }
 
@@ -474,6 +480,7 @@ StringReadDef(
     Tk_PhotoImageBlock srcBlock;
     Display *display;
     Colormap colormap;
+    Tcl_HashTable colorCache;
     struct FormatOptions opts;
     int optIndex;
 
@@ -561,6 +568,14 @@ StringReadDef(
     curPixelPtr = srcBlock.pixelPtr;
     display = Tk_Display(Tk_MainWindow(interp));
     colormap = Tk_Colormap(Tk_MainWindow(interp));
+
+    /*
+     * Icons and other small images are often made of a handful of named
+     * colors repeated over and over. Resolving a color name is expensive, so
+     * remember the values of the names already seen during this call.
+     */
+
+    Tcl_InitHashTable(&colorCache, TCL_STRING_KEYS);
     for (y = srcY; y < rowCount; y++) {
         /*
          * We don't test the length of row, as that's been done in
@@ -573,20 +588,23 @@ StringReadDef(
         }
         for (x = srcX; x < colCount; x++) {
             if (ParseColor(interp, colListPtr[x], display, colormap,
-                    curPixelPtr, curPixelPtr + 1, curPixelPtr + 2,
-                    curPixelPtr + 3) != TCL_OK) {
+                    &colorCache, curPixelPtr, curPixelPtr + 1,
+                    curPixelPtr + 2, curPixelPtr + 3) != TCL_OK) {
                 goto errorExit;
             }
             curPixelPtr += 4;
         }
     }
 
+    Tcl_DeleteHashTable(&colorCache);
+
     /*
      * Write image data to destHandle
      */
     if (Tk_PhotoPutBlock(interp, imageHandle, &srcBlock, destX, destY,
             width, height, TK_PHOTO_COMPOSITE_SET) != TCL_OK) {
-        goto errorExit;
+        ckfree(srcBlock.pixelPtr);
+        return TCL_ERROR;
     }
 
     ckfree(srcBlock.pixelPtr);
@@ -594,6 +612,7 @@ StringReadDef(
     return TCL_OK;
 
   errorExit:
+    Tcl_DeleteHashTable(&colorCache);
     ckfree(srcBlock.pixelPtr);
 
     return TCL_ERROR;
@@ -624,7 +643,7 @@ StringWriteDef(
     Tk_PhotoImageBlock *blockPtr)       /* The image data to convert */
 {
     int greenOffset, blueOffset, alphaOffset, hasAlpha;
-    Tcl_Obj *result, **objv = NULL;
+    Tcl_Obj **objv = NULL;
     int objc, allowedOpts, optIndex;
     struct FormatOptions opts;
 
@@ -665,44 +684,91 @@ StringWriteDef(
     }
 
     if ((blockPtr->width > 0) && (blockPtr->height > 0)) {
-        int row, col;
+        int row, col, pixelChars;
         Tcl_DString data, line;
         char colorBuf[11];
+        char *linePtr;
         unsigned char *pixelPtr;
         unsigned char alphaVal = 255;
 
+        /*
+         * Every pixel of the #XXX formats takes a fixed number of characters
+         * (including the separating blank), and one of the list format takes
+         * at most "{255 255 255 255} ". Reserve the space for the whole
+         * result up front instead of growing the strings pixel by pixel.
+         */
+
+        switch (opts.colorFormat) {
+        case COLORFORMAT_RGB2:
+            pixelChars = 8;
+            break;
+        case COLORFORMAT_RGBA2:
+            pixelChars = 10;
+            break;
+        case COLORFORMAT_LIST:
+            pixelChars = 18;
+            break;
+        default:
+            Tcl_Panic("unexpected switch fallthrough");
+            return TCL_ERROR;
+        }
         Tcl_DStringInit(&data);
+        Tcl_DStringInit(&line);
+        if ((double) blockPtr->width * pixelChars * blockPtr->height
+                < (double) (INT_MAX / 2)) {
+            Tcl_DStringSetLength(&data,
+                    (blockPtr->width * pixelChars + 3) * blockPtr->height);
+            Tcl_DStringSetLength(&data, 0);
+        }
+
         for (row=0; row<blockPtr->height; row++) {
             pixelPtr = blockPtr->pixelPtr + blockPtr->offset[0]
                     + row * blockPtr->pitch;
-            Tcl_DStringInit(&line);
-            for (col=0; col<blockPtr->width; col++) {
-                if (hasAlpha) {
-                    alphaVal = pixelPtr[alphaOffset];
+
+            /*
+             * We don't build lines as a list for #RGBA and #RGB. Since
+             * these color formats look like comments, the first element
+             * of the list would get quoted with an additional {} .
+             * While this is not a problem if the data is used as
+             * a list, it would cause problems if someone decides to parse
+             * it as a string (and it looks kinda strange)
+             */
+
+            if (opts.colorFormat != COLORFORMAT_LIST) {
+                Tcl_DStringSetLength(&line,
+                        blockPtr->width * pixelChars - 1);
+                linePtr = Tcl_DStringValue(&line);
+                for (col=0; col<blockPtr->width; col++) {
+                    *linePtr++ = '#';
+                    *linePtr++ = hexDigits[pixelPtr[0] >> 4];
+                    *linePtr++ = hexDigits[pixelPtr[0] & 0xf];
+                    *linePtr++ = hexDigits[pixelPtr[greenOffset] >> 4];
+                    *linePtr++ = hexDigits[pixelPtr[greenOffset] & 0xf];
+                    *linePtr++ = hexDigits[pixelPtr[blueOffset] >> 4];
+                    *linePtr++ = hexDigits[pixelPtr[blueOffset] & 0xf];
+                    if (opts.colorFormat == COLORFORMAT_RGBA2) {
+                        if (hasAlpha) {
+                            alphaVal = pixelPtr[alphaOffset];
+                        }
+                        *linePtr++ = hexDigits[alphaVal >> 4];
+                        *linePtr++ = hexDigits[alphaVal & 0xf];
+                    }
+                    *linePtr++ = ' ';
+                    pixelPtr += blockPtr->pixelSize;
                 }
 
                 /*
-                 * We don't build lines as a list for #RGBA and #RGB. Since
-                 * these color formats look like comments, the first element
-                 * of the list would get quoted with an additional {} .
-                 * While this is not a problem if the data is used as
-                 * a list, it would cause problems if someone decides to parse
-                 * it as a string (and it looks kinda strange)
+                 * The blank after the last pixel overwrote the terminating
+                 * null character. Put it back.
                  */
 
-                switch (opts.colorFormat) {
-                case COLORFORMAT_RGB2:
-                    sprintf(colorBuf, "#%02x%02x%02x ",  pixelPtr[0],
-                            pixelPtr[greenOffset], pixelPtr[blueOffset]);
-                    Tcl_DStringAppend(&line, colorBuf, -1);
-                    break;
-                case COLORFORMAT_RGBA2:
-                    sprintf(colorBuf, "#%02x%02x%02x%02x ",
-                            pixelPtr[0], pixelPtr[greenOffset],
-                            pixelPtr[blueOffset], alphaVal);
-                    Tcl_DStringAppend(&line, colorBuf, -1);
-                    break;
-                case COLORFORMAT_LIST:
+                linePtr[-1] = '\0';
+            } else {
+                Tcl_DStringSetLength(&line, 0);
+                for (col=0; col<blockPtr->width; col++) {
+                    if (hasAlpha) {
+                        alphaVal = pixelPtr[alphaOffset];
+                    }
                     Tcl_DStringStartSublist(&line);
                     sprintf(colorBuf, "%d", pixelPtr[0]);
                     Tcl_DStringAppendElement(&line, colorBuf);
@@ -713,31 +779,17 @@ StringWriteDef(
                     sprintf(colorBuf, "%d", alphaVal);
                     Tcl_DStringAppendElement(&line, colorBuf);
                     Tcl_DStringEndSublist(&line);
-                    break;
-                default:
-                    Tcl_Panic("unexpected switch fallthrough");
+                    pixelPtr += blockPtr->pixelSize;
                 }
-                pixelPtr += blockPtr->pixelSize;
-            }
-            if (opts.colorFormat != COLORFORMAT_LIST) {
-                /*
-                 * For the #XXX formats, we need to remove the last
-                 * whitespace.
-                 */
-
-                *(Tcl_DStringValue(&line) + Tcl_DStringLength(&line) - 1)
-                        = '\0';
             }
             Tcl_DStringAppendElement(&data, Tcl_DStringValue(&line));
-            Tcl_DStringFree(&line);
         }
-        result = Tcl_NewStringObj(Tcl_DStringValue(&data), -1);
-        Tcl_DStringFree(&data);
+        Tcl_DStringFree(&line);
+        Tcl_DStringResult(interp, &data);
     } else {
-        result = Tcl_NewObj();
+        Tcl_SetObjResult(interp, Tcl_NewObj());
     }
 
-    Tcl_SetObjResult(interp, result);
     return TCL_OK;
 }
 
@@ -758,7 +810,8 @@ StringWriteDef(
  *      interp. Returns a standard Tcl result.
  *
  * Side effects:
- *      None.
+ *      If cachePtr is not NULL, colors that had to be parsed as standard Tk
+ *      colors are added to the cache, and later looked up there.
  *
  *----------------------------------------------------------------------
  */
@@ -769,6 +822,8 @@ ParseColor(
     Display *display,           /* display of main window, needed to parse
                                  * standard Tk colors */
     Colormap colormap,          /* colormap of current display */
+    Tcl_HashTable *cachePtr,    /* maps color strings to already parsed
+                                 * RGBA values, or NULL */
     unsigned char *redPtr,      /* the result is written to these pointers */
     unsigned char *greenPtr,
     unsigned char *bluePtr,
@@ -776,6 +831,9 @@ ParseColor(
 {
     const char *specString;
     TkSizeT charCount;
+    Tcl_HashEntry *hPtr;
+    unsigned int rgba;
+    int isNew;
 
     /*
      * Find out which color format we have
@@ -795,23 +853,44 @@ ParseColor(
         return TCL_ERROR;
     }
     if (specString[0] == '#') {
-        return ParseColorAsHex(interp, specString, charCount, display,
-                colormap, redPtr, greenPtr, bluePtr, alphaPtr);
-    }
-    if (ParseColorAsList(interp, specString, charCount,
+        if (ParseColorAsHex(specString, charCount,
+                redPtr, greenPtr, bluePtr, alphaPtr) == TCL_OK) {
+            return TCL_OK;
+        }
+    } else if (ParseColorAsList(interp, specString, charCount,
             redPtr, greenPtr, bluePtr, alphaPtr) == TCL_OK) {
         return TCL_OK;
     }
 
+    if (cachePtr != NULL) {
+        hPtr = Tcl_FindHashEntry(cachePtr, specString);
+        if (hPtr != NULL) {
+            rgba = (unsigned int) PTR2UINT(Tcl_GetHashValue(hPtr));
+            *redPtr = (unsigned char) (rgba >> 24);
+            *greenPtr = (unsigned char) ((rgba >> 16) & 0xff);
+            *bluePtr = (unsigned char) ((rgba >> 8) & 0xff);
+            *alphaPtr = (unsigned char) (rgba & 0xff);
+            return TCL_OK;
+        }
+    }
+
     /*
      * Parsing the color as standard Tk color always is the last option tried
      * because TkParseColor() is very slow with values it cannot parse.
      */
 
     Tcl_ResetResult(interp);
-    return ParseColorAsStandard(interp, specString, charCount, display,
-            colormap, redPtr, greenPtr, bluePtr, alphaPtr);
-
+    if (ParseColorAsStandard(interp, specString, charCount, display,
+            colormap, redPtr, greenPtr, bluePtr, alphaPtr) != TCL_OK) {
+        return TCL_ERROR;
+    }
+    if (cachePtr != NULL) {
+        rgba = ((unsigned int) *redPtr << 24) | ((unsigned int) *greenPtr << 16)
+                | ((unsigned int) *bluePtr << 8) | *alphaPtr;
+        hPtr = Tcl_CreateHashEntry(cachePtr, specString, &isNew);
+        Tcl_SetHashValue(hPtr, UINT2PTR(rgba));
+    }
+    return TCL_OK;
 }
 
 /*
@@ -902,8 +981,10 @@ ParseColorAsList(
  * ParseColorAsHex --
  *
  *      This function extracts color and alpha values from a string
- *      starting with '#', followed by hex digits. It undestands both
- *      the #RGBA form and the #RBG (with optional suffix)
+ *      starting with '#', followed by 4, 6 or 8 hex digits, i.e. the
+ *      #RGBA, #RRGGBB and #RRGGBBAA forms. Everything else starting with
+ *      '#' (e.g. #RGB or a color with an alpha suffix) is left to
+ *      ParseColorAsStandard.
  *
  * Results:
  *      On success, writes red, green, blue and alpha values to the
@@ -912,42 +993,44 @@ ParseColorAsList(
  *      Returns a standard Tcl result.
  *
  * Side effects:
- *      None.
+ *      Does *not* leave error messages in interp, the caller falls back to
+ *      the slower ParseColorAsStandard if this fails.
  *
  *----------------------------------------------------------------------
  */
 static int
 ParseColorAsHex(
-    Tcl_Interp *interp,         /* error messages are left here */
     const char *colorString,    /* the color data to parse */
     int colorStrLen,            /* length of the color string */
-    Display *display,           /* display of main window */
-    Colormap colormap,          /* colormap of current display */
     unsigned char *redPtr,      /* the result is written to these pointers */
     unsigned char *greenPtr,
     unsigned char *bluePtr,
     unsigned char *alphaPtr)
 {
-    int i;
+    int i, digit;
     unsigned long int colorValue = 0;
 
-    if (colorStrLen - 1 != 4 && colorStrLen - 1 != 8) {
-        return ParseColorAsStandard(interp, colorString, colorStrLen,
-                display, colormap, redPtr, greenPtr, bluePtr, alphaPtr);
+    if (colorStrLen - 1 != 4 && colorStrLen - 1 != 6
+            && colorStrLen - 1 != 8) {
+        return TCL_ERROR;
     }
     for (i = 1; i < colorStrLen; i++) {
-        if (!isxdigit(UCHAR(colorString[i]))) {
+        digit = UCHAR(colorString[i]);
+        if (digit >= '0' && digit <= '9') {
+            digit -= '0';
+        } else if ((digit | 0x20) >= 'a' && (digit | 0x20) <= 'f') {
+            digit = (digit | 0x20) - 'a' + 10;
+        } else {
             /*
              * There still is a chance that this is a Tk color with
              * an alpha suffix
              */
 
-            return ParseColorAsStandard(interp, colorString, colorStrLen,
-                    display, colormap, redPtr, greenPtr, bluePtr, alphaPtr);
+            return TCL_ERROR;
         }
+        colorValue = (colorValue << 4) | digit;
     }
 
-    colorValue = strtoul(colorString + 1, NULL, 16);
     switch (colorStrLen - 1) {
     case 4:
         /* #RGBA format */
@@ -956,6 +1039,13 @@ ParseColorAsHex(
         *bluePtr = (unsigned char) (((colorValue >> 4) & 0xf) * 0x11);
         *alphaPtr = (unsigned char) ((colorValue & 0xf) * 0x11);
         return TCL_OK;
+    case 6:
+        /* #RRGGBB format, same as the standard Tk color */
+        *redPtr = (unsigned char) (colorValue >> 16);
+        *greenPtr = (unsigned char) ((colorValue >> 8) & 0xff);
+        *bluePtr = (unsigned char) (colorValue & 0xff);
+        *alphaPtr = 255;
+        return TCL_OK;
     case 8:
         /* #RRGGBBAA format */
         *redPtr = (unsigned char) (colorValue >> 24);
@@ -970,7 +1060,7 @@ ParseColorAsHex(
     /* Shouldn't get here */
     return TCL_ERROR;
 }
-
+
 /*
  *----------------------------------------------------------------------
  *
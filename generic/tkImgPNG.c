@@ -2359,7 +2359,8 @@ ParseFormat(
  * DecodePNG --
  *
  *	This function handles the entirety of reading a PNG file (or data)
- *	from the first byte to the last.
+ *	from the first byte to the last. If imageHandle is NULL, the decoded
+ *	pixels are only left in pngPtr->block.
  *
  * Results:
  *	TCL_OK, or TCL_ERROR if an I/O error occurs or any problems are
@@ -2483,8 +2484,9 @@ DecodePNG(
      * to negative here: Tk will not shrink the image.
      */
 
-    if (Tk_PhotoExpand(interp, imageHandle, destX + pngPtr->block.width,
-	    destY + pngPtr->block.height) == TCL_ERROR) {
+    if ((imageHandle != NULL) && (Tk_PhotoExpand(interp, imageHandle,
+	    destX + pngPtr->block.width, destY + pngPtr->block.height)
+	    == TCL_ERROR)) {
 	return TCL_ERROR;
     }
 
@@ -2638,7 +2640,8 @@ DecodePNG(
      * Copy the decoded image block into the Tk photo image.
      */
 
-    if (Tk_PhotoPutBlock(interp, imageHandle, &pngPtr->block, destX, destY,
+    if ((imageHandle != NULL) && Tk_PhotoPutBlock(interp, imageHandle,
+	    &pngPtr->block, destX, destY,
 	    pngPtr->block.width, pngPtr->block.height,
 	    TK_PHOTO_COMPOSITE_SET) == TCL_ERROR) {
 	return TCL_ERROR;
@@ -2836,6 +2839,52 @@ StringReadPNG(
     return result;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkImgPNGDecodeBlock --
+ *
+ *	This function decodes PNG data from an object into a newly allocated
+ *	image block, without involving a photo image. It uses no state other
+ *	than its arguments, so it may be called from any thread, provided that
+ *	interp and dataObj belong to that thread.
+ *
+ * Results:
+ *	A standard TCL completion code. On success *blockPtr describes the
+ *	decoded pixels; its pixelPtr must be freed with ckfree. If TCL_ERROR
+ *	is returned then an error message is left in the interp's result.
+ *
+ * Side effects:
+ *	Memory is allocated for the pixels.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+TkImgPNGDecodeBlock(
+    Tcl_Interp *interp,		/* Interpreter for error reporting. */
+    Tcl_Obj *dataObj,		/* PNG data, binary or base64 encoded. */
+    Tcl_Obj *fmtObj,		/* Format options (png -alpha value), or
+				 * NULL. */
+    Tk_PhotoImageBlock *blockPtr)
+				/* Filled in with the decoded pixels. */
+{
+    PNGImage png;
+    int result;
+
+    result = InitPNGImage(interp, &png, NULL, dataObj,
+	    TCL_ZLIB_STREAM_INFLATE);
+    if (TCL_OK == result) {
+	result = DecodePNG(interp, &png, fmtObj, NULL, 0, 0);
+    }
+    if (TCL_OK == result) {
+	*blockPtr = png.block;
+	png.block.pixelPtr = NULL;
+    }
+    CleanupPNGImage(&png);
+    return result;
+}
+
 /*
  *----------------------------------------------------------------------
  *
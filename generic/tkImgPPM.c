@@ -140,9 +140,10 @@ FileReadPPM(
     int srcX, int srcY)		/* Coordinates of top-left pixel to be used in
 				 * image being read. */
 {
-    int fileWidth, fileHeight, maxIntensity;
+    int fileWidth, fileHeight, maxIntensity, fileRowBytes, windowed;
     int nLines, h, type, bytesPerChannel = 1;
     size_t nBytes, count;
+    Tcl_WideInt skip;
     unsigned char *pixelPtr;
     Tk_PhotoImageBlock block;
 
@@ -193,15 +194,29 @@ FileReadPPM(
     }
     block.offset[3] = 0;
     block.width = width;
-    block.pitch = block.pixelSize * fileWidth;
+    fileRowBytes = block.pixelSize * fileWidth;
+
+    /*
+     * When only a narrow window of a wide image is wanted, read just the
+     * columns of that window from each line and seek over the rest, so that
+     * the cost depends on the size of the window rather than on the size of
+     * the file. Otherwise read whole lines, which is cheaper than seeking.
+     */
+
+    windowed = (width * block.pixelSize * 2 < fileRowBytes);
+    block.pitch = windowed ? width * block.pixelSize : fileRowBytes;
 
     if (Tk_PhotoExpand(interp, imageHandle,
 	    destX + width, destY + height) != TCL_OK) {
 	return TCL_ERROR;
     }
 
-    if (srcY > 0) {
-	Tcl_Seek(chan, (Tcl_WideInt)(srcY * block.pitch), SEEK_CUR);
+    skip = (Tcl_WideInt) srcY * fileRowBytes;
+    if (windowed) {
+	skip += (Tcl_WideInt) srcX * block.pixelSize;
+    }
+    if ((skip > 0) && (Tcl_Seek(chan, skip, SEEK_CUR) < 0)) {
+	goto readError;
     }
 
     nLines = (MAX_MEMORY + block.pitch - 1) / block.pitch;
@@ -213,23 +228,36 @@ FileReadPPM(
     }
     nBytes = nLines * block.pitch;
     pixelPtr = (unsigned char *)ckalloc(nBytes);
-    block.pixelPtr = pixelPtr + srcX * block.pixelSize;
+    block.pixelPtr = windowed ? pixelPtr : pixelPtr + srcX * block.pixelSize;
 
     for (h = height; h > 0; h -= nLines) {
 	if (nLines > h) {
 	    nLines = h;
 	    nBytes = nLines * block.pitch;
 	}
-	count = Tcl_Read(chan, (char *) pixelPtr, nBytes);
-	if (count != nBytes) {
-	    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
-		    "error reading PPM image file \"%s\": %s", fileName,
-		    Tcl_Eof(chan)?"not enough data":Tcl_PosixError(interp)));
-	    if (Tcl_Eof(chan)) {
-		Tcl_SetErrorCode(interp, "TK", "IMAGE", "PPM", "EOF", NULL);
+	if (windowed) {
+	    int line;
+
+	    count = 0;
+	    for (line = 0; line < nLines; line++) {
+		if ((line > 0 || h < height) && (Tcl_Seek(chan,
+			(Tcl_WideInt) (fileRowBytes - block.pitch),
+			SEEK_CUR) < 0)) {
+		    break;
+		}
+		if ((size_t) Tcl_Read(chan, (char *) pixelPtr
+			+ line * block.pitch, block.pitch)
+			!= (size_t) block.pitch) {
+		    break;
+		}
+		count += block.pitch;
 	    }
+	} else {
+	    count = Tcl_Read(chan, (char *) pixelPtr, nBytes);
+	}
+	if (count != nBytes) {
 	    ckfree(pixelPtr);
-	    return TCL_ERROR;
+	    goto readError;
 	}
 	if (maxIntensity < 0x00ff) {
 	    unsigned char *p;
@@ -241,7 +269,7 @@ FileReadPPM(
 	    unsigned char *p;
 	    unsigned int value;
 
-	    for (p = pixelPtr; count > 0; count--, p += 2) {
+	    for (p = pixelPtr; count > 1; count -= 2, p += 2) {
 		value = ((unsigned int) p[0]) * 256 + ((unsigned int) p[1]);
 		value = value * 255 / maxIntensity;
 		p[0] = p[1] = (unsigned char) value;
@@ -258,6 +286,15 @@ FileReadPPM(
 
     ckfree(pixelPtr);
     return TCL_OK;
+
+  readError:
+    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+	    "error reading PPM image file \"%s\": %s", fileName,
+	    Tcl_Eof(chan)?"not enough data":Tcl_PosixError(interp)));
+    if (Tcl_Eof(chan)) {
+	Tcl_SetErrorCode(interp, "TK", "IMAGE", "PPM", "EOF", NULL);
+    }
+    return TCL_ERROR;
 }
 
 /*
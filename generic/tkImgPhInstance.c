@@ -45,11 +45,31 @@ static void		BlendComplexAlpha(XImage *bgImg, PhotoInstance *iPtr,
 static int		IsValidPalette(PhotoInstance *instancePtr,
 			    const char *palette);
 static int		CountBits(unsigned mask);
+static void		DitherDirtyTiles(PhotoInstance *instancePtr, int x,
+			    int y, int width, int height);
 static void		GetColorTable(PhotoInstance *instancePtr);
 static void		FreeColorTable(ColorTable *colorPtr, int force);
 static void		AllocateColors(ColorTable *colorPtr);
 static void		DisposeColorTable(ClientData clientData);
 static int		ReclaimColors(ColorTableId *id, int numColors);
+static void		DisposeInstanceProc(ClientData clientData);
+static void		UnlinkLingeringInstance(PhotoInstance *instancePtr);
+static size_t		InstanceMemory(PhotoInstance *instancePtr);
+
+/*
+ * Instances that are no longer used by any widget, but not yet freed, are
+ * kept in a per-thread list ordered by the time they were released.
+ */
+
+typedef struct {
+    PhotoInstance *lingerFirstPtr;
+				/* Least recently released instance. */
+    PhotoInstance *lingerLastPtr;
+				/* Most recently released instance. */
+    size_t lingeringBytes;	/* Sum of the lingerBytes of the instances in
+				 * the list. */
+} ThreadSpecificData;
+static Tcl_ThreadDataKey dataKey;
 
 /*
  * Hash table used to hash from (display, colormap, palette, gamma) to
@@ -179,16 +199,15 @@ TkImgPhotoConfigureInstance(
     }
 
     /*
-     * Redither this instance if necessary.
+     * Redither this instance if necessary. The actual dithering happens when
+     * the affected parts of the image are next displayed.
      */
 
     if ((modelPtr->flags & IMAGE_CHANGED)
 	    || (instancePtr->colorTablePtr != colorTablePtr)) {
 	TkClipBox(modelPtr->validRegion, &validBox);
-	if ((validBox.width > 0) && (validBox.height > 0)) {
-	    TkImgDitherInstance(instancePtr, validBox.x, validBox.y,
-		    validBox.width, validBox.height);
-	}
+	TkImgMarkInstanceDirty(instancePtr, validBox.x, validBox.y,
+		validBox.width, validBox.height);
     }
 }
 
@@ -205,7 +224,10 @@ TkImgPhotoConfigureInstance(
  *
  * Side effects:
  *	A data structure is set up for the instance (or, an existing instance
- *	is re-used for the new one).
+ *	is re-used for the new one). Instances are shared between windows
+ *	using the same colormap, and between windows using TrueColor visuals
+ *	that only differ in their colormap, since the pixel values of those
+ *	don't depend on the colormap.
  *
  *----------------------------------------------------------------------
  */
@@ -254,30 +276,79 @@ TkImgPhotoGet(
      */
 
     colormap = Tk_Colormap(tkwin);
+    visInfoPtr = NULL;
     for (instancePtr = modelPtr->instancePtr; instancePtr != NULL;
 	    instancePtr = instancePtr->nextPtr) {
 	if ((colormap == instancePtr->colormap)
 		&& (Tk_Display(tkwin) == instancePtr->display)) {
-	    /*
-	     * Re-use this instance.
-	     */
+	    break;
+	}
+    }
 
-	    if (instancePtr->refCount == 0) {
-		/*
-		 * We are resurrecting this instance.
-		 */
+    if (instancePtr == NULL) {
+	/*
+	 * Obtain information about the visual. With a TrueColor visual, an
+	 * instance made for another colormap works just as well, as long as
+	 * the pixel layout is the same. Its colors stay allocated in its own
+	 * colormap, which it keeps preserved until it is freed, so that
+	 * colormap outlives the window the instance was made for.
+	 */
 
-		Tcl_CancelIdleCall(TkImgDisposeInstance, instancePtr);
-		if (instancePtr->colorTablePtr != NULL) {
-		    FreeColorTable(instancePtr->colorTablePtr, 0);
+	visualInfo.screen = Tk_ScreenNumber(tkwin);
+	visualInfo.visualid = XVisualIDFromVisual(Tk_Visual(tkwin));
+	visInfoPtr = XGetVisualInfo(Tk_Display(tkwin),
+		VisualScreenMask | VisualIDMask, &visualInfo, &numVisuals);
+	if (visInfoPtr == NULL) {
+	    Tcl_Panic("TkImgPhotoGet couldn't find visual for window");
+	}
+	if (visInfoPtr->c_class == TrueColor) {
+	    for (instancePtr = modelPtr->instancePtr; instancePtr != NULL;
+		    instancePtr = instancePtr->nextPtr) {
+		if ((Tk_Display(tkwin) == instancePtr->display)
+			&& (instancePtr->visualInfo.c_class == TrueColor)
+			&& (instancePtr->visualInfo.screen
+				== visInfoPtr->screen)
+			&& (instancePtr->visualInfo.depth
+				== visInfoPtr->depth)
+			&& (instancePtr->visualInfo.red_mask
+				== visInfoPtr->red_mask)
+			&& (instancePtr->visualInfo.green_mask
+				== visInfoPtr->green_mask)
+			&& (instancePtr->visualInfo.blue_mask
+				== visInfoPtr->blue_mask)) {
+		    break;
 		}
-		GetColorTable(instancePtr);
 	    }
-	    instancePtr->refCount++;
-	    return instancePtr;
+	}
+	if (instancePtr != NULL) {
+	    XFree((char *) visInfoPtr);
 	}
     }
 
+    if (instancePtr != NULL) {
+	/*
+	 * Re-use this instance.
+	 */
+
+	if (instancePtr->refCount == 0) {
+	    /*
+	     * We are resurrecting this instance.
+	     */
+
+	    if (instancePtr->disposeTimer != NULL) {
+		Tcl_DeleteTimerHandler(instancePtr->disposeTimer);
+		instancePtr->disposeTimer = NULL;
+	    }
+	    UnlinkLingeringInstance(instancePtr);
+	    if (instancePtr->colorTablePtr != NULL) {
+		FreeColorTable(instancePtr->colorTablePtr, 0);
+	    }
+	    GetColorTable(instancePtr);
+	}
+	instancePtr->refCount++;
+	return instancePtr;
+    }
+
     /*
      * The image isn't already in use in a window with the same colormap. Make
      * a new instance of the image.
@@ -295,21 +366,21 @@ TkImgPhotoGet(
     instancePtr->width = 0;
     instancePtr->height = 0;
     instancePtr->imagePtr = 0;
+    instancePtr->dirtyTiles = NULL;
+    instancePtr->tileColumns = 0;
+    instancePtr->tileRows = 0;
+    instancePtr->numDirtyTiles = 0;
+    instancePtr->disposeTimer = NULL;
+    instancePtr->lingerPrevPtr = NULL;
+    instancePtr->lingerNextPtr = NULL;
+    instancePtr->lingerBytes = 0;
     instancePtr->nextPtr = modelPtr->instancePtr;
     modelPtr->instancePtr = instancePtr;
 
     /*
-     * Obtain information about the visual and decide on the default palette.
+     * Decide on the default palette.
      */
 
-    visualInfo.screen = Tk_ScreenNumber(tkwin);
-    visualInfo.visualid = XVisualIDFromVisual(Tk_Visual(tkwin));
-    visInfoPtr = XGetVisualInfo(Tk_Display(tkwin),
-	    VisualScreenMask | VisualIDMask, &visualInfo, &numVisuals);
-    if (visInfoPtr == NULL) {
-	Tcl_Panic("TkImgPhotoGet couldn't find visual for window");
-    }
-
     nRed = 2;
     nGreen = nBlue = 0;
     mono = 1;
@@ -692,6 +763,7 @@ TkImgPhotoDisplay(
 	 */
 
     fallBack:
+	DitherDirtyTiles(instancePtr, imageX, imageY, width, height);
 	TkSetRegion(display, instancePtr->gc,
 		instancePtr->modelPtr->validRegion);
 	XSetClipOrigin(display, instancePtr->gc, drawableX - imageX,
@@ -719,7 +791,9 @@ TkImgPhotoDisplay(
  *	None.
  *
  * Side effects:
- *	Internal data structures get cleaned up, later.
+ *	Internal data structures get cleaned up, later. If the unused
+ *	instances waiting for that take more than PHOTO_MAX_LINGERING_BYTES,
+ *	the oldest of them are freed at the next opportunity.
  *
  *----------------------------------------------------------------------
  */
@@ -732,7 +806,10 @@ TkImgPhotoFree(
 				 * image. */
 {
     PhotoInstance *instancePtr = (PhotoInstance *)clientData;
+    PhotoInstance *oldestPtr;
     ColorTable *colorPtr;
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
     (void)display;
 
     if (instancePtr->refCount-- > 1) {
@@ -742,8 +819,8 @@ TkImgPhotoFree(
     /*
      * There are no more uses of the image within this widget. Decrement the
      * count of live uses of its color table, so that its colors can be
-     * reclaimed if necessary, and set up an idle call to free the instance
-     * structure.
+     * reclaimed if necessary, and set up a timer to free the instance
+     * structure, unless it is needed again before.
      */
 
     colorPtr = instancePtr->colorTablePtr;
@@ -751,7 +828,142 @@ TkImgPhotoFree(
 	colorPtr->liveRefCount--;
     }
 
-    Tcl_DoWhenIdle(TkImgDisposeInstance, instancePtr);
+    instancePtr->disposeTimer = Tcl_CreateTimerHandler(PHOTO_LINGER_TIME,
+	    DisposeInstanceProc, instancePtr);
+    instancePtr->lingerPrevPtr = tsdPtr->lingerLastPtr;
+    instancePtr->lingerNextPtr = NULL;
+    if (tsdPtr->lingerLastPtr != NULL) {
+	tsdPtr->lingerLastPtr->lingerNextPtr = instancePtr;
+    } else {
+	tsdPtr->lingerFirstPtr = instancePtr;
+    }
+    tsdPtr->lingerLastPtr = instancePtr;
+    instancePtr->lingerBytes = InstanceMemory(instancePtr);
+    tsdPtr->lingeringBytes += instancePtr->lingerBytes;
+
+    /*
+     * Don't let unused instances pile up. Freeing the oldest ones right here
+     * could pull them out from under a caller that is walking its model's
+     * instance list, so just make their timers expire immediately. This
+     * includes the instance just released if it is too big on its own.
+     */
+
+    while (tsdPtr->lingeringBytes > PHOTO_MAX_LINGERING_BYTES) {
+	oldestPtr = tsdPtr->lingerFirstPtr;
+	UnlinkLingeringInstance(oldestPtr);
+	Tcl_DeleteTimerHandler(oldestPtr->disposeTimer);
+	oldestPtr->disposeTimer = Tcl_CreateTimerHandler(0,
+		DisposeInstanceProc, oldestPtr);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * DisposeInstanceProc --
+ *
+ *	Timer handler that frees a photo instance which has not been used
+ *	again since it was released.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The instance is freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+DisposeInstanceProc(
+    ClientData clientData)	/* Pointer to the instance to free. */
+{
+    PhotoInstance *instancePtr = (PhotoInstance *)clientData;
+
+    instancePtr->disposeTimer = NULL;
+    TkImgDisposeInstance(instancePtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * UnlinkLingeringInstance --
+ *
+ *	Removes an instance from the list of unused instances waiting to be
+ *	freed, if it is in there.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The per-thread list of lingering instances is updated.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+UnlinkLingeringInstance(
+    PhotoInstance *instancePtr)	/* Instance to remove from the list. */
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+
+    if (instancePtr->lingerPrevPtr == NULL
+	    && tsdPtr->lingerFirstPtr != instancePtr) {
+	return;
+    }
+    if (instancePtr->lingerPrevPtr != NULL) {
+	instancePtr->lingerPrevPtr->lingerNextPtr = instancePtr->lingerNextPtr;
+    } else {
+	tsdPtr->lingerFirstPtr = instancePtr->lingerNextPtr;
+    }
+    if (instancePtr->lingerNextPtr != NULL) {
+	instancePtr->lingerNextPtr->lingerPrevPtr = instancePtr->lingerPrevPtr;
+    } else {
+	tsdPtr->lingerLastPtr = instancePtr->lingerPrevPtr;
+    }
+    instancePtr->lingerPrevPtr = NULL;
+    instancePtr->lingerNextPtr = NULL;
+    tsdPtr->lingeringBytes -= instancePtr->lingerBytes;
+    instancePtr->lingerBytes = 0;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * InstanceMemory --
+ *
+ *	Estimates the memory held by a photo instance: its pixmap, dithering
+ *	error array and the image used to transfer dithered pixels.
+ *
+ * Results:
+ *	The number of bytes.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static size_t
+InstanceMemory(
+    PhotoInstance *instancePtr)	/* Instance to measure. */
+{
+    size_t numPixels = (size_t) instancePtr->width * instancePtr->height;
+    size_t bytes = sizeof(PhotoInstance);
+    int depth = instancePtr->visualInfo.depth;
+
+    if (instancePtr->pixels != None) {
+	bytes += numPixels * ((depth > 16) ? 4 : (depth > 8) ? 2 : 1);
+    }
+    if (instancePtr->error != NULL) {
+	bytes += numPixels * 3 * sizeof(schar);
+    }
+    if (instancePtr->imagePtr != NULL) {
+	bytes += (size_t) instancePtr->imagePtr->bytes_per_line
+		* instancePtr->imagePtr->height;
+    }
+    return bytes;
 }
 
 /*
@@ -778,7 +990,8 @@ TkImgPhotoInstanceSetSize(
 {
     PhotoModel *modelPtr;
     schar *newError, *errSrcPtr, *errDestPtr;
-    int h, offset;
+    int h, offset, tileColumns, tileRows;
+    unsigned char *newTiles;
     XRectangle validBox;
     Pixmap newPixmap;
 
@@ -892,6 +1105,47 @@ TkImgPhotoInstanceSetSize(
 	instancePtr->error = newError;
     }
 
+    /*
+     * Resize the dirty tile map. Tiles are anchored at the top-left corner
+     * of the image, so any tile that was dirty before and still exists stays
+     * dirty.
+     */
+
+    tileColumns = (modelPtr->width + PHOTO_TILE_SIZE - 1) / PHOTO_TILE_SIZE;
+    tileRows = (modelPtr->height + PHOTO_TILE_SIZE - 1) / PHOTO_TILE_SIZE;
+    if ((tileColumns != instancePtr->tileColumns)
+	    || (tileRows != instancePtr->tileRows)) {
+	int numDirty = 0;
+
+	newTiles = NULL;
+	if (tileColumns > 0 && tileRows > 0) {
+	    newTiles = (unsigned char *)ckalloc(tileColumns * tileRows);
+	    memset(newTiles, 0, (size_t) tileColumns * tileRows);
+	    if (instancePtr->numDirtyTiles > 0) {
+		int row, col;
+
+		for (row = 0; row < MIN(tileRows, instancePtr->tileRows);
+			row++) {
+		    for (col = 0; col < MIN(tileColumns,
+			    instancePtr->tileColumns); col++) {
+			if (instancePtr->dirtyTiles[
+				row * instancePtr->tileColumns + col]) {
+			    newTiles[row * tileColumns + col] = 1;
+			    numDirty++;
+			}
+		    }
+		}
+	    }
+	}
+	if (instancePtr->dirtyTiles != NULL) {
+	    ckfree(instancePtr->dirtyTiles);
+	}
+	instancePtr->dirtyTiles = newTiles;
+	instancePtr->tileColumns = tileColumns;
+	instancePtr->tileRows = tileRows;
+	instancePtr->numDirtyTiles = numDirty;
+    }
+
     instancePtr->width = modelPtr->width;
     instancePtr->height = modelPtr->height;
 }
@@ -1589,6 +1843,10 @@ TkImgDisposeInstance(
     PhotoInstance *instancePtr = (PhotoInstance *)clientData;
     PhotoInstance *prevPtr;
 
+    if (instancePtr->disposeTimer != NULL) {
+	Tcl_DeleteTimerHandler(instancePtr->disposeTimer);
+    }
+    UnlinkLingeringInstance(instancePtr);
     if (instancePtr->pixels != None) {
 	Tk_FreePixmap(instancePtr->display, instancePtr->pixels);
     }
@@ -1601,6 +1859,9 @@ TkImgDisposeInstance(
     if (instancePtr->error != NULL) {
 	ckfree(instancePtr->error);
     }
+    if (instancePtr->dirtyTiles != NULL) {
+	ckfree(instancePtr->dirtyTiles);
+    }
     if (instancePtr->colorTablePtr != NULL) {
 	FreeColorTable(instancePtr->colorTablePtr, 1);
     }
@@ -1961,6 +2222,142 @@ TkImgDitherInstance(
     ckfree(imagePtr->data);
     imagePtr->data = NULL;
 }
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkImgMarkInstanceDirty --
+ *
+ *	This function is called to record that an area of an instance's
+ *	pixmap no longer matches the model. The area is redithered lazily, the
+ *	next time some part of it is displayed.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The tiles of the instance covering the area are flagged as dirty.
+ *
+ *----------------------------------------------------------------------
+ */
+
+void
+TkImgMarkInstanceDirty(
+    PhotoInstance *instancePtr,	/* The instance to be updated. */
+    int x, int y,		/* Coordinates of the top-left pixel of the
+				 * changed area. */
+    int width, int height)	/* Dimensions of the changed area. */
+{
+    int row, col, colStart, colEnd, rowEnd;
+    unsigned char *tilePtr;
+
+    if (instancePtr->dirtyTiles == NULL) {
+	return;
+    }
+    if (x < 0) {
+	width += x;
+	x = 0;
+    }
+    if (y < 0) {
+	height += y;
+	y = 0;
+    }
+    if (x + width > instancePtr->width) {
+	width = instancePtr->width - x;
+    }
+    if (y + height > instancePtr->height) {
+	height = instancePtr->height - y;
+    }
+    if ((width <= 0) || (height <= 0)) {
+	return;
+    }
+
+    colStart = x / PHOTO_TILE_SIZE;
+    colEnd = (x + width - 1) / PHOTO_TILE_SIZE;
+    rowEnd = (y + height - 1) / PHOTO_TILE_SIZE;
+    for (row = y / PHOTO_TILE_SIZE; row <= rowEnd; row++) {
+	tilePtr = instancePtr->dirtyTiles + row * instancePtr->tileColumns;
+	for (col = colStart; col <= colEnd; col++) {
+	    if (!tilePtr[col]) {
+		tilePtr[col] = 1;
+		instancePtr->numDirtyTiles++;
+	    }
+	}
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * DitherDirtyTiles --
+ *
+ *	This function brings the part of an instance's pixmap that is about
+ *	to be displayed up to date, by dithering each dirty tile that
+ *	intersects the given area. Horizontally adjacent dirty tiles are
+ *	dithered together.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The instance's pixmap gets updated and the tiles are marked clean.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+DitherDirtyTiles(
+    PhotoInstance *instancePtr,	/* The instance about to be displayed. */
+    int x, int y,		/* Coordinates of the top-left pixel of the
+				 * area to be displayed. */
+    int width, int height)	/* Dimensions of the area to be displayed. */
+{
+    int row, col, runStart, colEnd, rowEnd, tileX, tileY;
+    unsigned char *tilePtr;
+
+    if (instancePtr->numDirtyTiles == 0) {
+	return;
+    }
+    if (x < 0) {
+	width += x;
+	x = 0;
+    }
+    if (y < 0) {
+	height += y;
+	y = 0;
+    }
+    if (x + width > instancePtr->width) {
+	width = instancePtr->width - x;
+    }
+    if (y + height > instancePtr->height) {
+	height = instancePtr->height - y;
+    }
+    if ((width <= 0) || (height <= 0)) {
+	return;
+    }
+
+    colEnd = (x + width - 1) / PHOTO_TILE_SIZE;
+    rowEnd = (y + height - 1) / PHOTO_TILE_SIZE;
+    for (row = y / PHOTO_TILE_SIZE; row <= rowEnd; row++) {
+	tilePtr = instancePtr->dirtyTiles + row * instancePtr->tileColumns;
+	tileY = row * PHOTO_TILE_SIZE;
+	for (col = x / PHOTO_TILE_SIZE; col <= colEnd; ) {
+	    if (!tilePtr[col]) {
+		col++;
+		continue;
+	    }
+	    runStart = col;
+	    while ((col <= colEnd) && tilePtr[col]) {
+		tilePtr[col++] = 0;
+		instancePtr->numDirtyTiles--;
+	    }
+	    tileX = runStart * PHOTO_TILE_SIZE;
+	    TkImgDitherInstance(instancePtr, tileX, tileY,
+		    MIN(col * PHOTO_TILE_SIZE, instancePtr->width) - tileX,
+		    MIN(tileY + PHOTO_TILE_SIZE, instancePtr->height) - tileY);
+	}
+    }
+}
 
 /*
  *----------------------------------------------------------------------
@@ -1974,7 +2371,8 @@ TkImgDitherInstance(
  *	None.
  *
  * Side effects:
- *	The instance's dither buffer gets cleared.
+ *	The instance's dither buffer gets cleared and any pending redithering
+ *	of its tiles is discarded.
  *
  *----------------------------------------------------------------------
  */
@@ -1988,6 +2386,11 @@ TkImgResetDither(
 		(size_t) instancePtr->modelPtr->width
 		* instancePtr->modelPtr->height * 3 * sizeof(schar));
     }
+    if (instancePtr->dirtyTiles) {
+	memset(instancePtr->dirtyTiles, 0,
+		(size_t) instancePtr->tileColumns * instancePtr->tileRows);
+	instancePtr->numDirtyTiles = 0;
+    }
 }
 
 /*
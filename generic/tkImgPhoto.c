@@ -2126,7 +2126,6 @@ ImgPhotoDelete(
 	if (instancePtr->refCount > 0) {
 	    Tcl_Panic("tried to delete photo image when instances still exist");
 	}
-	Tcl_CancelIdleCall(TkImgDisposeInstance, instancePtr);
 	TkImgDisposeInstance(instancePtr);
     }
     modelPtr->tkModel = NULL;
@@ -2726,6 +2725,31 @@ Tk_FindPhoto(
     }
     return clientData;
 }
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkPhotoGetChangeStamp --
+ *
+ *	Return the change stamp of the image model behind a photo handle; see
+ *	TkGetImageChangeStamp. Used to validate caches of data converted from
+ *	the photo's pixels.
+ *
+ * Results:
+ *	The photo's current change stamp.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+unsigned long
+TkPhotoGetChangeStamp(
+    Tk_PhotoHandle handle)	/* Handle for the photo image. */
+{
+    return TkGetImageChangeStamp(((PhotoModel *) handle)->tkModel);
+}
 
 /*
  *----------------------------------------------------------------------
@@ -3093,7 +3117,13 @@ Tk_PhotoPutBlock(
 		(unsigned) y, (unsigned) width, (unsigned) height,
 		modelPtr->pix32 + (y * modelPtr->width + x) * 4 + 3,
 		4, (unsigned) modelPtr->width * 4);
-    } else {
+    } else if (TkRectInRegion(modelPtr->validRegion, x, y,
+	    (unsigned) width, (unsigned) height) != RectangleIn) {
+	/*
+	 * Only touch the region when the block extends it; repeated updates
+	 * of an already valid area (animations, overlays) are common.
+	 */
+
 	rect.x = x;
 	rect.y = y;
 	rect.width = width;
@@ -3456,7 +3486,13 @@ Tk_PhotoPutZoomedBlock(
 		(unsigned)x, (unsigned)y, (unsigned)width, (unsigned)height,
 		&modelPtr->pix32[(y * modelPtr->width + x) * 4 + 3], 4,
 		(unsigned) modelPtr->width * 4);
-    } else {
+    } else if (TkRectInRegion(modelPtr->validRegion, x, y,
+	    (unsigned) width, (unsigned) height) != RectangleIn) {
+	/*
+	 * Only touch the region when the block extends it; repeated updates
+	 * of an already valid area (animations, overlays) are common.
+	 */
+
 	rect.x = x;
 	rect.y = y;
 	rect.width = width;
@@ -3530,9 +3566,10 @@ Tk_PhotoPutZoomedBlock(
  *	None.
  *
  * Side effects:
- *	The pixmap of each instance of this image gets updated. The fields in
- *	*modelPtr indicating which area of the image is correctly dithered
- *	get updated.
+ *	The tiles of each instance's pixmap covering the area are marked as
+ *	out of date; they get redithered when they are next displayed. The
+ *	fields in *modelPtr indicating which area of the image is correctly
+ *	dithered get updated.
  *
  *----------------------------------------------------------------------
  */
@@ -3554,7 +3591,7 @@ Tk_DitherPhoto(
 
     for (instancePtr = modelPtr->instancePtr; instancePtr != NULL;
 	    instancePtr = instancePtr->nextPtr) {
-	TkImgDitherInstance(instancePtr, x, y, width, height);
+	TkImgMarkInstanceDirty(instancePtr, x, y, width, height);
     }
 
     /*
@@ -3704,6 +3741,114 @@ Tk_PhotoExpand(
     return TCL_OK;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * Tk_PhotoDecodeBlock --
+ *
+ *	This function decodes image data into a newly allocated image block
+ *	that can later be given to Tk_PhotoPutBlock. Unlike reading data into
+ *	a photo image, it doesn't touch any Tk state, so it may be called
+ *	from any thread, e.g. to decode images on worker threads while the
+ *	photo images are filled in by the thread that owns them. The
+ *	interpreter and data object must belong to the calling thread.
+ *
+ *	Only the "png" and "svg" formats are supported. If formatObj is NULL,
+ *	the data is tried as PNG, then as SVG.
+ *
+ * Results:
+ *	A standard Tcl result. On success *blockPtr describes the decoded
+ *	pixels, which must be released with Tk_PhotoFreeBlock. If TCL_ERROR is
+ *	returned then an error message is left in the interp's result.
+ *
+ * Side effects:
+ *	Memory is allocated for the pixels.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+Tk_PhotoDecodeBlock(
+    Tcl_Interp *interp,		/* Interpreter for error reporting; must
+				 * belong to the calling thread. */
+    Tcl_Obj *dataObj,		/* Image data. */
+    Tcl_Obj *formatObj,		/* Format name and options, as for the
+				 * -format option of photo images, or
+				 * NULL. */
+    Tk_PhotoImageBlock *blockPtr)
+				/* Filled in with the decoded pixels. */
+{
+    Tcl_Obj *nameObj;
+    const char *name;
+
+    if (formatObj == NULL) {
+	int code;
+
+	/*
+	 * The PNG decoder releases its reference to the data, which would
+	 * free an unshared object before the SVG decoder gets to see it.
+	 */
+
+	Tcl_IncrRefCount(dataObj);
+	code = TkImgPNGDecodeBlock(interp, dataObj, NULL, blockPtr);
+	if (code != TCL_OK) {
+	    code = TkImgSVGDecodeBlock(interp, dataObj, NULL, blockPtr);
+	}
+	Tcl_DecrRefCount(dataObj);
+	if (code == TCL_OK) {
+	    return TCL_OK;
+	}
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		"couldn't recognize image data", -1));
+	Tcl_SetErrorCode(interp, "TK", "IMAGE", "PHOTO",
+		"UNRECOGNIZED_DATA", NULL);
+	return TCL_ERROR;
+    }
+
+    if (Tcl_ListObjIndex(interp, formatObj, 0, &nameObj) != TCL_OK) {
+	return TCL_ERROR;
+    }
+    name = (nameObj == NULL) ? "" : Tcl_GetString(nameObj);
+    if (strncasecmp(name, "png", 4) == 0) {
+	return TkImgPNGDecodeBlock(interp, dataObj, formatObj, blockPtr);
+    }
+    if (strncasecmp(name, "svg", 4) == 0) {
+	return TkImgSVGDecodeBlock(interp, dataObj, formatObj, blockPtr);
+    }
+    Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+	    "image format \"%s\" can't be decoded into a block", name));
+    Tcl_SetErrorCode(interp, "TK", "LOOKUP", "PHOTO_FORMAT", name, NULL);
+    return TCL_ERROR;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * Tk_PhotoFreeBlock --
+ *
+ *	This function releases the pixels of a block returned by
+ *	Tk_PhotoDecodeBlock. It may be called from any thread.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The block's pixel memory is freed and its pixelPtr reset to NULL.
+ *
+ *----------------------------------------------------------------------
+ */
+
+void
+Tk_PhotoFreeBlock(
+    Tk_PhotoImageBlock *blockPtr)
+				/* Block whose pixels are released. */
+{
+    if (blockPtr->pixelPtr != NULL) {
+	ckfree(blockPtr->pixelPtr);
+	blockPtr->pixelPtr = NULL;
+    }
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -56,6 +56,27 @@ typedef struct PhotoModel	PhotoModel;
 
 #define MAX_PIXELS 65536
 
+/*
+ * Each instance keeps track of which parts of its pixmap are out of date in
+ * square tiles of the following size (in pixels). Changes to the model only
+ * mark the tiles they touch as dirty; the tiles are dithered into the pixmap
+ * when some part of them actually has to be displayed.
+ */
+
+#define PHOTO_TILE_SIZE 64
+
+/*
+ * An instance that is no longer used by any widget is kept around for the
+ * following number of milliseconds before it is freed, so that widgets which
+ * are destroyed and recreated can pick up the already dithered pixmap. The
+ * pixmaps, dithering error arrays and images of such instances may take at
+ * most PHOTO_MAX_LINGERING_BYTES per thread; beyond that the least recently
+ * released instances are freed first.
+ */
+
+#define PHOTO_LINGER_TIME		1000
+#define PHOTO_MAX_LINGERING_BYTES	(16 * 1024 * 1024)
+
 /*
  * The set of colors required to display a photo image in a window depends on:
  *	- the visual used by the window
@@ -192,14 +213,19 @@ struct PhotoModel {
 
 /*
  * The following data structure represents all of the instances of a photo
- * image in windows on a given screen that are using the same colormap.
+ * image in windows on a given screen that are using the same colormap, or
+ * TrueColor visuals with the same depth and color masks.
  */
 
 struct PhotoInstance {
     PhotoModel *modelPtr;	/* Pointer to model for image. */
     Display *display;		/* Display for windows using this instance. */
-    Colormap colormap;		/* The image may only be used in windows with
-				 * this particular colormap. */
+    Colormap colormap;		/* Colormap the colors of the instance are
+				 * allocated in. The image may only be used
+				 * in windows with this colormap, or with
+				 * another colormap of a matching TrueColor
+				 * visual. Preserved with Tk_PreserveColormap
+				 * until the instance is freed. */
     PhotoInstance *nextPtr;	/* Pointer to the next instance in the list of
 				 * instances associated with this model. */
 #if TCL_MAJOR_VERSION > 8
@@ -222,6 +248,23 @@ struct PhotoInstance {
 				 * windows are using. */
     GC gc;			/* Graphics context for writing images to the
 				 * pixmap. */
+    unsigned char *dirtyTiles;	/* One byte per PHOTO_TILE_SIZE square tile
+				 * of the pixmap, in row-major order. Non-zero
+				 * means the tile has to be redithered before
+				 * it is displayed. NULL if the image is
+				 * empty. */
+    int tileColumns, tileRows;	/* Dimensions of the dirtyTiles array. */
+    int numDirtyTiles;		/* Number of non-zero entries in
+				 * dirtyTiles. */
+    Tcl_TimerToken disposeTimer;/* Timer that frees this instance once it has
+				 * been unused for PHOTO_LINGER_TIME, or NULL
+				 * if the instance is in use. */
+    PhotoInstance *lingerPrevPtr, *lingerNextPtr;
+				/* Neighbours in the per-thread list of
+				 * unused instances waiting to be freed,
+				 * least recently released first. */
+    size_t lingerBytes;		/* Memory charged to that list for this
+				 * instance when it was released. */
 };
 
 /*
@@ -250,6 +293,8 @@ MODULE_SCOPE void	TkImgPhotoInstanceSetSize(PhotoInstance *instancePtr);
 MODULE_SCOPE ClientData	TkImgPhotoGet(Tk_Window tkwin, ClientData clientData);
 MODULE_SCOPE void	TkImgDitherInstance(PhotoInstance *instancePtr, int x,
 			    int y, int width, int height);
+MODULE_SCOPE void	TkImgMarkInstanceDirty(PhotoInstance *instancePtr,
+			    int x, int y, int width, int height);
 MODULE_SCOPE void	TkImgPhotoDisplay(ClientData clientData,
 			    Display *display, Drawable drawable,
 			    int imageX, int imageY, int width, int height,
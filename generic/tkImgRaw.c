@@ -0,0 +1,441 @@
+/*
+ * tkImgRaw.c --
+ *
+ *	A photo image string handler for raw pixel data. The data is a byte
+ *	array holding the pixels of the image, row by row without any padding
+ *	or header, in one of a small number of fixed channel layouts. This
+ *	makes it possible to move image data between photo images and other
+ *	packages or extensions without converting every pixel to and from a
+ *	string.
+ *
+ *	This image format cannot read/write files, it is meant for string
+ *	data only.
+ *
+ * See the file "license.terms" for information on usage and redistribution of
+ * this file, and for a DISCLAIMER OF ALL WARRANTIES.
+ */
+
+#include "tkInt.h"
+
+/*
+ * Message to generate when an attempt to allocate memory for an image fails.
+ */
+
+#define TK_PHOTO_ALLOC_FAILURE_MESSAGE \
+	"not enough free memory for image buffer"
+
+/*
+ * The channel layouts understood by the handler. For each layout, the table
+ * gives the number of bytes per pixel and the position of the red, green,
+ * blue and alpha bytes within a pixel (-1 if the layout has no alpha).
+ */
+
+static const char *const layoutNames[] = {
+    "rgba8", "rgb8", "bgra8", "bgr8", NULL
+};
+
+static const struct {
+    int pixelSize;
+    int offset[4];
+} layouts[] = {
+    {4, {0, 1, 2, 3}},
+    {3, {0, 1, 2, -1}},
+    {4, {2, 1, 0, 3}},
+    {3, {2, 1, 0, -1}}
+};
+
+/*
+ * The following data structure is used to return information from
+ * ParseRawFormat:
+ */
+
+typedef struct {
+    int layout;			/* Index into layouts[]. */
+    int width, height;		/* Values of -width and -height, or -1 if
+				 * not given. */
+} RawFormat;
+
+/*
+ * Forward declarations
+ */
+
+static int		ParseRawFormat(Tcl_Interp *interp, Tcl_Obj *fmtObj,
+			    RawFormat *fmtPtr);
+static int		StringMatchRaw(Tcl_Obj *dataObj, Tcl_Obj *fmtObj,
+			    int *widthPtr, int *heightPtr, Tcl_Interp *interp);
+static int		StringReadRaw(Tcl_Interp *interp, Tcl_Obj *dataObj,
+			    Tcl_Obj *fmtObj, Tk_PhotoHandle imageHandle,
+			    int destX, int destY, int width, int height,
+			    int srcX, int srcY);
+static int		StringWriteRaw(Tcl_Interp *interp, Tcl_Obj *fmtObj,
+			    Tk_PhotoImageBlock *blockPtr);
+
+/*
+ * The format record for the raw image handler:
+ */
+
+Tk_PhotoImageFormat tkImgFmtRaw = {
+    "raw",			/* name */
+    NULL,			/* fileMatchProc: no file support */
+    StringMatchRaw,		/* stringMatchProc */
+    NULL,			/* fileReadProc: no file support */
+    StringReadRaw,		/* stringReadProc */
+    NULL,			/* fileWriteProc: no file support */
+    StringWriteRaw,		/* stringWriteProc */
+    NULL			/* nextPtr */
+};
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * ParseRawFormat --
+ *
+ *	Parse the suboptions given with the value of the -format option.
+ *
+ * Results:
+ *	A standard Tcl result. On success, *fmtPtr is filled in with the
+ *	values given or with the defaults.
+ *
+ * Side effects:
+ *	Leaves an error message in interp on failure.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+ParseRawFormat(
+    Tcl_Interp *interp,		/* For error messages. */
+    Tcl_Obj *fmtObj,		/* Value of the -format option. */
+    RawFormat *fmtPtr)		/* Parsed values are written here. */
+{
+    Tcl_Obj **objv = NULL;
+    int objc = 0;
+    static const char *const fmtOptions[] = {
+	"-height", "-layout", "-width", NULL
+    };
+    enum fmtOptionsEnum {
+	OPT_HEIGHT, OPT_LAYOUT, OPT_WIDTH
+    };
+
+    fmtPtr->layout = 0;
+    fmtPtr->width = -1;
+    fmtPtr->height = -1;
+
+    if (fmtObj &&
+	    Tcl_ListObjGetElements(interp, fmtObj, &objc, &objv) != TCL_OK) {
+	return TCL_ERROR;
+    }
+
+    for (; objc>0 ; objc--, objv++) {
+	int optIndex, *intPtr;
+
+	/*
+	 * Ignore the "raw" part of the format specification.
+	 */
+
+	if (!strcasecmp(Tcl_GetString(objv[0]), "raw")) {
+	    continue;
+	}
+
+	if (Tcl_GetIndexFromObjStruct(interp, objv[0], fmtOptions,
+		sizeof(char *), "option", 0, &optIndex) == TCL_ERROR) {
+	    return TCL_ERROR;
+	}
+
+	if (objc < 2) {
+	    Tcl_WrongNumArgs(interp, 1, objv, "value");
+	    return TCL_ERROR;
+	}
+
+	objc--;
+	objv++;
+
+	switch ((enum fmtOptionsEnum) optIndex) {
+	case OPT_LAYOUT:
+	    if (Tcl_GetIndexFromObjStruct(interp, objv[0], layoutNames,
+		    sizeof(char *), "layout", 0, &fmtPtr->layout) != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    break;
+	case OPT_HEIGHT:
+	case OPT_WIDTH:
+	    intPtr = (optIndex == OPT_WIDTH) ? &fmtPtr->width : &fmtPtr->height;
+	    if (Tcl_GetIntFromObj(interp, objv[0], intPtr) != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    if (*intPtr < 0) {
+		Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+			"%s value must not be negative", fmtOptions[optIndex]));
+		Tcl_SetErrorCode(interp, "TK", "IMAGE", "RAW", "BAD_SIZE",
+			NULL);
+		return TCL_ERROR;
+	    }
+	    break;
+	}
+    }
+
+    return TCL_OK;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * StringMatchRaw --
+ *
+ *	This function is invoked by the photo image type to see if an object
+ *	contains raw image data. As raw data has no signature, it is only
+ *	accepted when the "raw" format was explicitly requested; the size of
+ *	the image comes from the -width and (optionally) -height suboptions.
+ *
+ * Results:
+ *	The return value is 1 if the data can be read as raw data, 0
+ *	otherwise. In the latter case, an error message may be left in interp.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+StringMatchRaw(
+    Tcl_Obj *dataObj,		/* The data supplied by the user. */
+    Tcl_Obj *fmtObj,		/* User-specified format object, or NULL. */
+    int *widthPtr, int *heightPtr,
+				/* The dimensions of the image are returned
+				 * here. */
+    Tcl_Interp *interp)		/* Where to put error messages. */
+{
+    RawFormat fmt;
+    TkSizeT length;
+    int rowBytes;
+
+    if (fmtObj == NULL) {
+	return 0;
+    }
+    if (ParseRawFormat(interp, fmtObj, &fmt) != TCL_OK) {
+	return 0;
+    }
+    if (fmt.width < 0) {
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		"raw image data requires the -width format option", -1));
+	Tcl_SetErrorCode(interp, "TK", "IMAGE", "RAW", "NO_WIDTH", NULL);
+	return 0;
+    }
+    if (fmt.width > INT_MAX / layouts[fmt.layout].pixelSize) {
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		"raw image width is too large", -1));
+	Tcl_SetErrorCode(interp, "TK", "IMAGE", "RAW", "BAD_SIZE", NULL);
+	return 0;
+    }
+
+    (void) TkGetByteArrayFromObj(dataObj, &length);
+    rowBytes = fmt.width * layouts[fmt.layout].pixelSize;
+    if (fmt.height < 0) {
+	fmt.height = (rowBytes == 0) ? 0 : (int) (length / rowBytes);
+    } else if ((fmt.height > 0) && ((size_t) length
+	    < (size_t) rowBytes * (size_t) fmt.height)) {
+	Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		"raw image data too short for %dx%d pixels",
+		fmt.width, fmt.height));
+	Tcl_SetErrorCode(interp, "TK", "IMAGE", "RAW", "SHORT_DATA", NULL);
+	return 0;
+    }
+
+    *widthPtr = fmt.width;
+    *heightPtr = fmt.height;
+    return 1;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * StringReadRaw --
+ *
+ *	This function is called by the photo image type to read raw image
+ *	data from a byte array and write it into a given photo image. The
+ *	bytes are handed to Tk_PhotoPutBlock directly, without an
+ *	intermediate copy.
+ *
+ * Results:
+ *	A standard TCL completion code. If TCL_ERROR is returned then an error
+ *	message is left in the interp's result.
+ *
+ * Side effects:
+ *	New data is added to the image given by imageHandle.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+StringReadRaw(
+    Tcl_Interp *interp,		/* Interpreter to use for reporting errors. */
+    Tcl_Obj *dataObj,		/* The raw pixel data. */
+    Tcl_Obj *fmtObj,		/* User-specified format object, or NULL. */
+    Tk_PhotoHandle imageHandle,	/* The photo image to write into. */
+    int destX, int destY,	/* Coordinates of top-left pixel in photo
+				 * image to be written to. */
+    int width, int height,	/* Dimensions of block of photo image to be
+				 * written to. */
+    int srcX, int srcY)		/* Coordinates of top-left pixel to be used in
+				 * image being read. */
+{
+    RawFormat fmt;
+    Tk_PhotoImageBlock block;
+    int dataWidth, dataHeight;
+
+    if (!StringMatchRaw(dataObj, fmtObj, &dataWidth, &dataHeight, interp)) {
+	return TCL_ERROR;
+    }
+    if (ParseRawFormat(interp, fmtObj, &fmt) != TCL_OK) {
+	return TCL_ERROR;
+    }
+    if ((srcX + width) > dataWidth) {
+	width = dataWidth - srcX;
+    }
+    if ((srcY + height) > dataHeight) {
+	height = dataHeight - srcY;
+    }
+    if ((width <= 0) || (height <= 0)
+	    || (srcX >= dataWidth) || (srcY >= dataHeight)) {
+	return TCL_OK;
+    }
+
+    block.pixelSize = layouts[fmt.layout].pixelSize;
+    block.pitch = dataWidth * block.pixelSize;
+    block.width = dataWidth - srcX;
+    block.height = dataHeight - srcY;
+    block.offset[0] = layouts[fmt.layout].offset[0];
+    block.offset[1] = layouts[fmt.layout].offset[1];
+    block.offset[2] = layouts[fmt.layout].offset[2];
+    block.offset[3] = layouts[fmt.layout].offset[3];
+    if (block.offset[3] < 0) {
+	/*
+	 * Tk_PhotoPutBlock recognizes a missing alpha channel by an alpha
+	 * offset outside the pixel.
+	 */
+
+	block.offset[3] = block.pixelSize;
+    }
+    block.pixelPtr = Tcl_GetByteArrayFromObj(dataObj, NULL)
+	    + srcY * block.pitch + srcX * block.pixelSize;
+
+    return Tk_PhotoPutBlock(interp, imageHandle, &block, destX, destY,
+	    width, height, TK_PHOTO_COMPOSITE_SET);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * StringWriteRaw --
+ *
+ *	This function is invoked to write image data to a byte array in raw
+ *	format. When the layout of the block matches the requested layout,
+ *	whole rows are copied with memcpy.
+ *
+ * Results:
+ *	A standard TCL completion code. If TCL_ERROR is returned then an error
+ *	message is left in the interp's result. On success, the byte array is
+ *	the result of interp.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+StringWriteRaw(
+    Tcl_Interp *interp,		/* For the result and errors. */
+    Tcl_Obj *fmtObj,		/* The value of the -format option. */
+    Tk_PhotoImageBlock *blockPtr)
+				/* The image data to convert. */
+{
+    RawFormat fmt;
+    Tcl_Obj *resultObj;
+    unsigned char *destPtr, *srcLinePtr;
+    int x, y, dstSize, rowBytes, srcOffset[4], direct;
+
+    if (ParseRawFormat(interp, fmtObj, &fmt) != TCL_OK) {
+	return TCL_ERROR;
+    }
+    if (fmt.width >= 0 || fmt.height >= 0) {
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		"the -width and -height format options are only allowed "
+		"when reading raw image data", -1));
+	Tcl_SetErrorCode(interp, "TK", "IMAGE", "RAW", "BAD_OPTION", NULL);
+	return TCL_ERROR;
+    }
+
+    dstSize = layouts[fmt.layout].pixelSize;
+    if ((blockPtr->width > 0)
+	    && (blockPtr->height > INT_MAX / dstSize / blockPtr->width)) {
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		TK_PHOTO_ALLOC_FAILURE_MESSAGE, -1));
+	Tcl_SetErrorCode(interp, "TK", "MALLOC", NULL);
+	return TCL_ERROR;
+    }
+    rowBytes = blockPtr->width * dstSize;
+    resultObj = Tcl_NewByteArrayObj(NULL, 0);
+    destPtr = Tcl_SetByteArrayLength(resultObj, rowBytes * blockPtr->height);
+
+    /*
+     * Work out where each destination byte comes from. An alpha offset
+     * outside the pixel means the block has no alpha channel: either it is
+     * fully opaque (the photo image code only reports that when every alpha
+     * byte of its 4-byte pixels is 255, so such rows may still be copied
+     * directly), or -background has already composited it away.
+     */
+
+    direct = (blockPtr->pixelSize == dstSize);
+    for (x = 0; x < 4; x++) {
+	int dstOffset = layouts[fmt.layout].offset[x];
+
+	srcOffset[x] = blockPtr->offset[x];
+	if (x == 3 && (srcOffset[3] < 0
+		|| srcOffset[3] >= blockPtr->pixelSize)) {
+	    srcOffset[3] = -1;
+	    if (dstSize == 4 && dstOffset == 3) {
+		continue;
+	    }
+	}
+	if ((dstOffset >= 0) && (srcOffset[x] != dstOffset)) {
+	    direct = 0;
+	}
+    }
+
+    srcLinePtr = blockPtr->pixelPtr;
+    for (y = 0; y < blockPtr->height; y++) {
+	if (direct) {
+	    memcpy(destPtr, srcLinePtr, rowBytes);
+	    destPtr += rowBytes;
+	} else {
+	    const int *dstOffset = layouts[fmt.layout].offset;
+	    unsigned char *srcPtr = srcLinePtr;
+
+	    for (x = 0; x < blockPtr->width; x++) {
+		destPtr[dstOffset[0]] = srcPtr[srcOffset[0]];
+		destPtr[dstOffset[1]] = srcPtr[srcOffset[1]];
+		destPtr[dstOffset[2]] = srcPtr[srcOffset[2]];
+		if (dstOffset[3] >= 0) {
+		    destPtr[dstOffset[3]] =
+			    (srcOffset[3] < 0) ? 255 : srcPtr[srcOffset[3]];
+		}
+		srcPtr += blockPtr->pixelSize;
+		destPtr += dstSize;
+	    }
+	}
+	srcLinePtr += blockPtr->pitch;
+    }
+
+    Tcl_SetObjResult(interp, resultObj);
+    return TCL_OK;
+}
+
+/*
+ * Local Variables:
+ * mode: c
+ * c-basic-offset: 4
+ * fill-column: 78
+ * End:
+ */
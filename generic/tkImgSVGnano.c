@@ -71,7 +71,8 @@ static NSVGimage *	ParseSVGWithOptions(Tcl_Interp *interp,
 static int		RasterizeSVG(Tcl_Interp *interp,
 			    Tk_PhotoHandle imageHandle, NSVGimage *nsvgImage,
 			    int destX, int destY, int width, int height,
-			    int srcX, int srcY, RastOpts *ropts);
+			    int srcX, int srcY, RastOpts *ropts,
+			    Tk_PhotoImageBlock *blockPtr);
 static double		GetScaleFromParameters(NSVGimage *nsvgImage,
 			    RastOpts *ropts, int *widthPtr, int *heightPtr);
 static NSVGcache *	GetCachePtr(Tcl_Interp *interp);
@@ -81,6 +82,7 @@ static int		CacheSVG(Tcl_Interp *interp, ClientData dataOrChan,
 static NSVGimage *	GetCachedSVG(Tcl_Interp *interp, ClientData dataOrChan,
 			    Tcl_Obj *formatObj, RastOpts *ropts);
 static void		CleanCache(Tcl_Interp *interp);
+static int		SniffSVGFile(Tcl_Channel chan);
 static void		FreeCache(ClientData clientData, Tcl_Interp *interp);
 
 /*
@@ -125,13 +127,17 @@ FileMatchSVG(
     Tcl_Interp *interp)
 {
     TkSizeT length;
-    Tcl_Obj *dataObj = Tcl_NewObj();
+    Tcl_Obj *dataObj;
     const char *data;
     RastOpts ropts;
     NSVGimage *nsvgImage;
     (void)fileName;
 
     CleanCache(interp);
+    if (!SniffSVGFile(chan)) {
+	return 0;
+    }
+    dataObj = Tcl_NewObj();
     if (Tcl_ReadChars(chan, dataObj, -1, 0) == TCL_IO_FAILURE) {
 	/* in case of an error reading the file */
 	Tcl_DecrRefCount(dataObj);
@@ -154,6 +160,53 @@ FileMatchSVG(
     return 0;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * SniffSVGFile --
+ *
+ *	This function checks whether the start of a file could be SVG (i.e.
+ *	XML) data before FileMatchSVG reads and parses the whole file. Without
+ *	it, probing a large file of some other format that was given without
+ *	a -format option would read the complete file into memory.
+ *
+ * Results:
+ *	1 if the first character after an optional byte order mark and white
+ *	space is '<', 0 otherwise.
+ *
+ * Side effects:
+ *	None; the access position in chan is restored.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+SniffSVGFile(
+    Tcl_Channel chan)
+{
+    char buf[256];
+    TkSizeT i, count;
+    Tcl_WideInt start = Tcl_Tell(chan);
+
+    count = Tcl_Read(chan, buf, sizeof(buf));
+    if ((start < 0) || (Tcl_Seek(chan, start, SEEK_SET) < 0)) {
+	return 0;
+    }
+    if (count == TCL_IO_FAILURE) {
+	return 0;
+    }
+    i = 0;
+    if ((count >= 3) && ((unsigned char) buf[0] == 0xEF)
+	    && ((unsigned char) buf[1] == 0xBB)
+	    && ((unsigned char) buf[2] == 0xBF)) {
+	i = 3;
+    }
+    while ((i < count) && isspace(UCHAR(buf[i]))) {
+	i++;
+    }
+    return (i < count) && (buf[i] == '<');
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -209,7 +262,7 @@ FileReadSVG(
 	}
     }
     return RasterizeSVG(interp, imageHandle, nsvgImage, destX, destY,
-		width, height, srcX, srcY, &ropts);
+		width, height, srcX, srcY, &ropts, NULL);
 }
 
 /*
@@ -301,7 +354,67 @@ StringReadSVG(
 	return TCL_ERROR;
     }
     return RasterizeSVG(interp, imageHandle, nsvgImage, destX, destY,
-		width, height, srcX, srcY, &ropts);
+		width, height, srcX, srcY, &ropts, NULL);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkImgSVGDecodeBlock --
+ *
+ *	This function parses SVG data from an object and rasterizes it into a
+ *	newly allocated image block, without involving a photo image or the
+ *	per-interpreter cache of parsed images. It may be called from any
+ *	thread, provided that interp and dataObj belong to that thread.
+ *
+ * Results:
+ *	A standard TCL completion code. On success *blockPtr describes the
+ *	rasterized pixels; its pixelPtr must be freed with ckfree. If
+ *	TCL_ERROR is returned then an error message is left in the interp's
+ *	result.
+ *
+ * Side effects:
+ *	Memory is allocated for the pixels.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+TkImgSVGDecodeBlock(
+    Tcl_Interp *interp,		/* Interpreter for error reporting. */
+    Tcl_Obj *dataObj,		/* SVG data. */
+    Tcl_Obj *formatObj,		/* Format options (svg -scale value ...), or
+				 * NULL. */
+    Tk_PhotoImageBlock *blockPtr)
+				/* Filled in with the rasterized pixels. */
+{
+    TkSizeT length;
+    const char *data;
+    RastOpts ropts;
+    NSVGimage *nsvgImage;
+    int width, height;
+
+    data = TkGetStringFromObj(dataObj, &length);
+    nsvgImage = ParseSVGWithOptions(interp, data, length, formatObj, &ropts);
+    if (nsvgImage == NULL) {
+	return TCL_ERROR;
+    }
+
+    /*
+     * The parser accepts anything; as in the match procedures, data that
+     * yields an empty image is not SVG.
+     */
+
+    GetScaleFromParameters(nsvgImage, &ropts, &width, &height);
+    if ((width <= 0) || (height <= 0)) {
+	nsvgDelete(nsvgImage);
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		"couldn't recognize SVG data", -1));
+	Tcl_SetErrorCode(interp, "TK", "IMAGE", "SVG", "EMPTY", NULL);
+	return TCL_ERROR;
+    }
+    return RasterizeSVG(interp, NULL, nsvgImage, 0, 0, 0, 0, 0, 0, &ropts,
+	    blockPtr);
 }
 
 /*
@@ -491,7 +604,9 @@ error:
  * RasterizeSVG --
  *
  *	This function is called to rasterize the given nsvgImage and
- *	fill the imageHandle with data.
+ *	fill the imageHandle with data. If imageHandle is NULL, the whole
+ *	image is rasterized into a new block returned in *blockPtr instead;
+ *	its pixelPtr must be freed with ckfree.
  *
  * Results:
  *	A standard TCL completion code. If TCL_ERROR is returned then an error
@@ -512,7 +627,10 @@ RasterizeSVG(
     int destX, int destY,
     int width, int height,
     int srcX, int srcY,
-    RastOpts *ropts)
+    RastOpts *ropts,
+    Tk_PhotoImageBlock *blockPtr)
+				/* Where to return the pixels if imageHandle
+				 * is NULL. */
 {
     int w, h, c;
     NSVGrasterizer *rast;
@@ -548,6 +666,12 @@ RasterizeSVG(
     for (c = 0; c <= 3; c++) {
 	svgblock.offset[c] = c;
     }
+    if (imageHandle == NULL) {
+	*blockPtr = svgblock;
+	nsvgDeleteRasterizer(rast);
+	nsvgDelete(nsvgImage);
+	return TCL_OK;
+    }
     if (Tk_PhotoExpand(interp, imageHandle,
 		destX + width, destY + height) != TCL_OK) {
 	goto cleanRAST;
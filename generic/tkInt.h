@@ -202,6 +202,20 @@ typedef struct TkCaret {
 
 typedef enum TkLockUsage {LU_IGNORE, LU_CAPS, LU_SHIFT} TkLockUsage;
 
+/*
+ * The grab state of a window, as remembered by TkGrabState. Each display
+ * keeps TK_GRAB_CACHE_SIZE of these.
+ */
+
+#define TK_GRAB_CACHE_SIZE 16
+
+typedef struct TkGrabCacheEntry {
+    struct TkWindow *winPtr;	/* Window the entry describes, or NULL. */
+    unsigned int epoch;		/* Value of grabEpoch when state was
+				 * computed. */
+    int state;			/* Result of TkPositionInTree. */
+} TkGrabCacheEntry;
+
 typedef struct TkDisplay {
     Display *display;		/* Xlib's info about display. */
     struct TkDisplay *nextPtr;	/* Next in list of all displays. */
@@ -576,6 +590,23 @@ typedef struct TkDisplay {
     XIMStyle inputStyle;	/* Input style selected for this display. */
     XFontSet inputXfs;		/* XFontSet cached for over-the-spot XIM. */
 #endif /* TK_USE_INPUT_METHODS */
+    int wmWaitCount;		/* Number of times Tk has waited for the
+				 * window manager to respond to a request. */
+    int wmWaitTimeouts;		/* How many of those waits gave up. */
+    Tcl_WideInt wmWaitTime;	/* Total duration of those waits, in
+				 * microseconds. */
+    Tcl_WideInt wmWaitMaxTime;	/* Longest of those waits, in microseconds. */
+    unsigned int grabEpoch;	/* Incremented whenever grabWinPtr or the
+				 * set of toplevels changes, which invalidates
+				 * every entry of grabCache. Never zero once a
+				 * grab has been set. */
+    TkGrabCacheEntry grabCache[TK_GRAB_CACHE_SIZE];
+				/* Grab state of recently seen windows, hashed
+				 * on the window address; see TkGrabState. */
+    KeySym *keysymTable;	/* Keysyms for every keycode and the four
+				 * shift/mode-switch levels of group 0, filled
+				 * by TkpInitKeymapInfo when bindInfoStale is
+				 * set (X11 only). Malloc'ed, may be NULL. */
 } TkDisplay;
 
 /*
@@ -586,11 +617,15 @@ typedef struct TkDisplay {
  *	Whether to use input methods for this display
  *  TK_DISPLAY_WM_TRACING:		(default off)
  *	Whether we should do wm tracing on this display.
+ *  TK_DISPLAY_WM_ASYNC:		(default off)
+ *	Whether geometry and map requests for toplevels return without
+ *	waiting for the window manager, see [tk wmsync].
  */
 
 #define TK_DISPLAY_COLLAPSE_MOTION_EVENTS	(1 << 0)
 #define TK_DISPLAY_USE_IM			(1 << 1)
 #define TK_DISPLAY_WM_TRACING			(1 << 3)
+#define TK_DISPLAY_WM_ASYNC			(1 << 4)
 
 /*
  * One of the following structures exists for each error handler created by a
@@ -636,6 +671,23 @@ typedef struct TkEventHandler {
 				 * window (NULL means end of list). */
 } TkEventHandler;
 
+/*
+ * The phases of the initialization of an application whose duration is
+ * recorded in its TkMainInfo, and reported by [tk startupprofile]. The order
+ * must match the one of the names in tkCmds.c.
+ */
+
+enum TkStartupPhase {
+    TK_STARTUP_DISPLAY,		/* Connecting to the display and creating the
+				 * main window. */
+    TK_STARTUP_FONTS,		/* Initializing the font package. */
+    TK_STARTUP_OPTIONS,		/* Loading the option database. */
+    TK_STARTUP_SCRIPTS,		/* Sourcing tk.tcl and the library scripts it
+				 * loads at startup. */
+    TK_STARTUP_TOTAL,		/* All of Tk_Init. */
+    TK_STARTUP_PHASES
+};
+
 /*
  * Tk keeps one of the following data structures for each main window (created
  * by a call to TkCreateMainWindow). It stores information that is shared by
@@ -695,6 +747,10 @@ typedef struct TkMainInfo {
     struct TkMainInfo *nextPtr;	/* Next in list of all main windows managed by
 				 * this process. */
     Tcl_HashTable busyTable;	/* Information used by [tk busy] command. */
+    Tcl_WideInt startupTimes[TK_STARTUP_PHASES];
+				/* Microseconds spent in each phase of the
+				 * initialization of this application, see
+				 * enum TkStartupPhase. */
 } TkMainInfo;
 
 /*
@@ -1071,6 +1127,7 @@ MODULE_SCOPE void		(*tkHandleEventProc) (XEvent* eventPtr);
 MODULE_SCOPE Tk_PhotoImageFormat tkImgFmtDefault;
 MODULE_SCOPE Tk_PhotoImageFormat tkImgFmtPNG;
 MODULE_SCOPE Tk_PhotoImageFormat tkImgFmtPPM;
+MODULE_SCOPE Tk_PhotoImageFormat tkImgFmtRaw;
 MODULE_SCOPE Tk_PhotoImageFormat tkImgFmtSVGnano;
 MODULE_SCOPE TkMainInfo		*tkMainWindowList;
 MODULE_SCOPE Tk_ImageType	tkPhotoImageType;
@@ -1282,6 +1339,8 @@ MODULE_SCOPE int	TkSetGeometryContainer(Tcl_Interp *interp,
 MODULE_SCOPE void	TkFreeGeometryContainer(Tk_Window tkwin,
 			    const char *name);
 
+MODULE_SCOPE void	TkCacheAtomNames(Tk_Window tkwin, const Atom *atoms,
+			    int count);
 MODULE_SCOPE void	TkEventInit(void);
 MODULE_SCOPE void	TkRegisterObjTypes(void);
 MODULE_SCOPE int	TkDeadAppObjCmd(ClientData clientData,
@@ -1291,6 +1350,15 @@ MODULE_SCOPE int	TkCanvasGetCoordObj(Tcl_Interp *interp,
 			    double *doublePtr);
 MODULE_SCOPE int	TkGetDoublePixels(Tcl_Interp *interp, Tk_Window tkwin,
 			    const char *string, double *doublePtr);
+MODULE_SCOPE Tcl_WideInt TkGetMicroseconds(void);
+MODULE_SCOPE unsigned long TkGetImageChangeStamp(Tk_ImageModel imageModel);
+MODULE_SCOPE unsigned long TkPhotoGetChangeStamp(Tk_PhotoHandle handle);
+MODULE_SCOPE int	TkImgPNGDecodeBlock(Tcl_Interp *interp,
+			    Tcl_Obj *dataObj, Tcl_Obj *fmtObj,
+			    Tk_PhotoImageBlock *blockPtr);
+MODULE_SCOPE int	TkImgSVGDecodeBlock(Tcl_Interp *interp,
+			    Tcl_Obj *dataObj, Tcl_Obj *formatObj,
+			    Tk_PhotoImageBlock *blockPtr);
 MODULE_SCOPE int	TkPostscriptImage(Tcl_Interp *interp, Tk_Window tkwin,
 			    Tk_PostscriptInfo psInfo, XImage *ximage,
 			    int x, int y, int width, int height);
@@ -1322,6 +1390,7 @@ MODULE_SCOPE int	TkParsePadAmount(Tcl_Interp *interp,
 			    int *pad1Ptr, int *pad2Ptr);
 MODULE_SCOPE void       TkFocusSplit(TkWindow *winPtr);
 MODULE_SCOPE void       TkFocusJoin(TkWindow *winPtr);
+MODULE_SCOPE void	TkGrabTreeChanged(TkDisplay *dispPtr);
 MODULE_SCOPE void	TkpDrawCharsInContext(Display * display,
 			    Drawable drawable, GC gc, Tk_Font tkfont,
 			    const char *source, int numBytes, int rangeStart,
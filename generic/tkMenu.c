@@ -1497,6 +1497,7 @@ MenuWorldChanged(
 
     TkMenuConfigureDrawOptions(menuPtr);
     for (i = 0; i < menuPtr->numEntries; i++) {
+	menuPtr->entries[i]->entryFlags &= ~ENTRY_GEOMETRY_CACHED;
     	TkMenuConfigureEntryDrawOptions(menuPtr->entries[i],
 		menuPtr->entries[i]->index);
 	TkpConfigureMenuEntry(menuPtr->entries[i]);
@@ -1916,6 +1917,8 @@ ConfigureMenuEntry(
     Tk_SavedOptions errorStruct;
     int result;
 
+    mePtr->entryFlags &= ~ENTRY_GEOMETRY_CACHED;
+
     /*
      * If this entry is a check button or radio button, then remove its old
      * trace function.
@@ -162,6 +162,11 @@ typedef struct TkMenuEntry {
 				 * vertical dimension, including raised border
 				 * drawn around entry when active. */
     int y;			/* Y-coordinate of topmost pixel in entry. */
+    int labelGeomWidth;		/* Measured size of the label and of the */
+    int labelGeomHeight;	/* accelerator, kept by the geometry code */
+    int accelGeomWidth;		/* so that unchanged entries need not be */
+    int accelGeomHeight;	/* measured again. Only valid while the
+				 * ENTRY_GEOMETRY_CACHED flag is set. */
     GC textGC;			/* GC for drawing text in entry. NULL means
 				 * use overall textGC for menu. */
     GC activeGC;		/* GC for drawing text in entry when active.
@@ -215,6 +220,10 @@ typedef struct TkMenuEntry {
  * ENTRY_LAST_COLUMN:		Used by the drawing code. If the entry is in
  *				the last column, the space to its right needs
  *				to be filled.
+ * ENTRY_GEOMETRY_CACHED:	Non-zero means the labelGeom* and accelGeom*
+ *				fields hold valid measurements. Cleared
+ *				whenever the entry is reconfigured, its fonts
+ *				change or its image changes size.
  * ENTRY_PLATFORM_FLAG1 - 4	These flags are reserved for use by the
  *				platform-dependent implementation of menus
  *				and should not be used by anything else.
@@ -223,6 +232,7 @@ typedef struct TkMenuEntry {
 #define ENTRY_SELECTED		1
 #define ENTRY_NEEDS_REDISPLAY	2
 #define ENTRY_LAST_COLUMN	4
+#define ENTRY_GEOMETRY_CACHED	8
 #define ENTRY_PLATFORM_FLAG1	(1 << 30)
 #define ENTRY_PLATFORM_FLAG2	(1 << 29)
 #define ENTRY_PLATFORM_FLAG3	(1 << 28)
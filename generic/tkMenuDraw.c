@@ -831,7 +831,8 @@ TkMenuImageProc(
 				 * <=0). */
     int imgWidth, int imgHeight)/* New dimensions of image. */
 {
-    TkMenu *menuPtr = (TkMenu *)((TkMenuEntry *) clientData)->menuPtr;
+    TkMenuEntry *mePtr = (TkMenuEntry *)clientData;
+    TkMenu *menuPtr = mePtr->menuPtr;
     (void)x;
     (void)y;
     (void)width;
@@ -839,6 +840,7 @@ TkMenuImageProc(
     (void)imgWidth;
     (void)imgHeight;
 
+    mePtr->entryFlags &= ~ENTRY_GEOMETRY_CACHED;
     if ((menuPtr->tkwin != NULL) && !(menuPtr->menuFlags & RESIZE_PENDING)) {
 	menuPtr->menuFlags |= RESIZE_PENDING;
 	Tcl_DoWhenIdle(ComputeMenuGeometry, menuPtr);
@@ -18,7 +18,10 @@
 typedef struct PixelRep {
     double value;
     int units;
-    Tk_Window tkwin;
+    Screen *screen;		/* Screen returnValue was computed for, or
+				 * NULL if it hasn't been computed yet. */
+    int width, widthMM;		/* Size of the screen at that time, which "tk
+				 * scaling" may change. */
     int returnValue;
 } PixelRep;
 
@@ -61,10 +64,23 @@ static Tcl_ThreadDataKey dataKey;
 typedef struct MMRep {
     double value;
     int units;
-    Tk_Window tkwin;
+    Screen *screen;		/* Screen returnValue was computed for, or
+				 * NULL if it hasn't been computed yet. */
+    int width, widthMM;		/* Size of the screen at that time, which "tk
+				 * scaling" may change. */
     double returnValue;
 } MMRep;
 
+/*
+ * A cached conversion is valid for any window on the same screen, as long as
+ * the screen's resolution hasn't changed since.
+ */
+
+#define SAME_RESOLUTION(repPtr, scr)				\
+    ((repPtr)->screen == (scr)					\
+	    && (repPtr)->width == WidthOfScreen(scr)		\
+	    && (repPtr)->widthMM == WidthMMOfScreen(scr))
+
 /*
  * The following structure is the internal representation for window objects.
  * A WindowRep caches name-to-window lookups. The cache is invalid if tkwin is
@@ -286,6 +302,7 @@ GetPixelsFromObjEx(
     int result, fresh;
     double d;
     PixelRep *pixelPtr;
+    Screen *screen;
     static const double bias[] = {
 	1.0,	10.0,	25.4,	0.35278 /*25.4 / 72.0*/
     };
@@ -332,23 +349,28 @@ GetPixelsFromObjEx(
 	}
     } else {
 	pixelPtr = GET_COMPLEXPIXEL(objPtr);
-	if ((!fresh) && (pixelPtr->tkwin != tkwin)) {
+	screen = Tk_Screen(tkwin);
+	if ((!fresh) && (pixelPtr->screen != NULL)
+		&& !SAME_RESOLUTION(pixelPtr, screen)) {
 	    /*
-	     * In the case of exo-screen conversions of non-pixels, we force a
-	     * recomputation from the string.
+	     * In the case of exo-screen conversions of non-pixels, or after
+	     * the scaling changed, we force a recomputation from the string.
+	     * Windows on the same screen share the cached value.
 	     */
 
 	    FreePixelInternalRep(objPtr);
 	    goto retry;
 	}
-	if ((pixelPtr->tkwin != tkwin) || dblPtr) {
+	if ((pixelPtr->screen == NULL) || dblPtr) {
 	    d = pixelPtr->value;
 	    if (pixelPtr->units >= 0) {
-		d *= bias[pixelPtr->units] * WidthOfScreen(Tk_Screen(tkwin));
-		d /= WidthMMOfScreen(Tk_Screen(tkwin));
+		d *= bias[pixelPtr->units] * WidthOfScreen(screen);
+		d /= WidthMMOfScreen(screen);
 	    }
 	    pixelPtr->returnValue = (int) (d<0 ? d-0.5 : d+0.5);
-	    pixelPtr->tkwin = tkwin;
+	    pixelPtr->screen = screen;
+	    pixelPtr->width = WidthOfScreen(screen);
+	    pixelPtr->widthMM = WidthMMOfScreen(screen);
 	    if (dblPtr) {
 		*dblPtr = d;
 	    }
@@ -505,7 +527,9 @@ DupPixelInternalRep(
 	newPtr = (PixelRep *)ckalloc(sizeof(PixelRep));
 	newPtr->value = oldPtr->value;
 	newPtr->units = oldPtr->units;
-	newPtr->tkwin = oldPtr->tkwin;
+	newPtr->screen = oldPtr->screen;
+	newPtr->width = oldPtr->width;
+	newPtr->widthMM = oldPtr->widthMM;
 	newPtr->returnValue = oldPtr->returnValue;
 	SET_COMPLEXPIXEL(copyPtr, newPtr);
     }
@@ -590,7 +614,7 @@ SetPixelFromAny(
 
 	pixelPtr->value = d;
 	pixelPtr->units = units;
-	pixelPtr->tkwin = NULL;
+	pixelPtr->screen = NULL;
 	pixelPtr->returnValue = i;
 	SET_COMPLEXPIXEL(objPtr, pixelPtr);
     }
@@ -636,6 +660,7 @@ Tk_GetMMFromObj(
     int result;
     double d;
     MMRep *mmPtr;
+    Screen *screen;
     static const double bias[] = {
 	10.0,	25.4,	1.0,	0.35278 /*25.4 / 72.0*/
     };
@@ -647,16 +672,25 @@ Tk_GetMMFromObj(
 	}
     }
 
+    /*
+     * Only distances in pixels depend on the screen; the others are
+     * converted once.
+     */
+
     mmPtr = (MMRep *)objPtr->internalRep.twoPtrValue.ptr1;
-    if (mmPtr->tkwin != tkwin) {
+    screen = Tk_Screen(tkwin);
+    if ((mmPtr->screen == NULL) || ((mmPtr->units == -1)
+	    && !SAME_RESOLUTION(mmPtr, screen))) {
 	d = mmPtr->value;
 	if (mmPtr->units == -1) {
-	    d /= WidthOfScreen(Tk_Screen(tkwin));
-	    d *= WidthMMOfScreen(Tk_Screen(tkwin));
+	    d /= WidthOfScreen(screen);
+	    d *= WidthMMOfScreen(screen);
 	} else {
 	    d *= bias[mmPtr->units];
 	}
-	mmPtr->tkwin = tkwin;
+	mmPtr->screen = screen;
+	mmPtr->width = WidthOfScreen(screen);
+	mmPtr->widthMM = WidthMMOfScreen(screen);
 	mmPtr->returnValue = d;
     }
     *doublePtr = mmPtr->returnValue;
@@ -721,7 +755,9 @@ DupMMInternalRep(
     newPtr = (MMRep *)ckalloc(sizeof(MMRep));
     newPtr->value = oldPtr->value;
     newPtr->units = oldPtr->units;
-    newPtr->tkwin = oldPtr->tkwin;
+    newPtr->screen = oldPtr->screen;
+    newPtr->width = oldPtr->width;
+    newPtr->widthMM = oldPtr->widthMM;
     newPtr->returnValue = oldPtr->returnValue;
     copyPtr->internalRep.twoPtrValue.ptr1 = newPtr;
 }
@@ -873,7 +909,7 @@ SetMMFromAny(
     mmPtr = (MMRep *)ckalloc(sizeof(MMRep));
     mmPtr->value = d;
     mmPtr->units = units;
-    mmPtr->tkwin = NULL;
+    mmPtr->screen = NULL;
     mmPtr->returnValue	= d;
 
     objPtr->internalRep.twoPtrValue.ptr1 = mmPtr;
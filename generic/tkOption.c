@@ -1460,6 +1460,7 @@ OptionInit(
 {
     int i;
     Tcl_Interp *interp;
+    Tcl_WideInt startTime;
     ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
 	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
     Element *defaultMatchPtr = &tsdPtr->defaultMatch;
@@ -1493,10 +1494,13 @@ OptionInit(
      * interpreter for message logging.
      */
 
+    startTime = TkGetMicroseconds();
     mainPtr->optionRootPtr = NewArray(20);
     interp = Tcl_CreateInterp();
     GetDefaultOptions(interp, mainPtr->winPtr);
     Tcl_DeleteInterp(interp);
+    mainPtr->startupTimes[TK_STARTUP_OPTIONS] =
+	    TkGetMicroseconds() - startTime;
 }
 
 /*
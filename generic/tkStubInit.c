@@ -1332,6 +1332,9 @@ const TkStubs tkStubs = {
     Tk_NewWindowObj, /* 277 */
     Tk_SendVirtualEvent, /* 278 */
     Tk_FontGetDescription, /* 279 */
+    Tk_PhotoDecodeBlock, /* 280 */
+    Tk_PhotoFreeBlock, /* 281 */
+    Tk_InternAtoms, /* 282 */
 };
 
 /* !END!: Do not edit above this line. */
@@ -23,6 +23,7 @@
 #endif
 #include "tkInt.h"
 #include "tkText.h"
+#include "tkImgPhoto.h"
 
 #ifdef _WIN32
 #include "tkWinInt.h"
@@ -40,6 +41,10 @@
 #include "tkUnixInt.h"
 #endif
 
+#if defined(HAVE_XFT) && !defined(MAC_OSX_TK)
+#include <fontconfig/fontconfig.h>
+#endif
+
 /*
  * TCL_STORAGE_CLASS is set unconditionally to DLLEXPORT because the
  * Tcltest_Init declaration is in the source file itself, which is only
@@ -202,6 +207,14 @@ static int		TestprintfObjCmd(ClientData dummy,
 static int		TestwrapperObjCmd(ClientData dummy,
 			    Tcl_Interp *interp, int objc,
 			    Tcl_Obj * const objv[]);
+static int		TestinternatomsObjCmd(ClientData dummy,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj * const objv[]);
+#endif
+#if defined(HAVE_XFT) && !defined(MAC_OSX_TK)
+static int		TestfontconfigObjCmd(ClientData dummy,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj * const objv[]);
 #endif
 static void		TrivialCmdDeletedProc(ClientData clientData);
 static int		TrivialConfigObjCmd(ClientData dummy,
@@ -212,6 +225,13 @@ static void		TrivialEventProc(ClientData clientData,
 static int              TestPhotoStringMatchCmd(ClientData dummy,
                             Tcl_Interp *interp, int objc,
                             Tcl_Obj * const objv[]);
+static int		TestphotodecodeObjCmd(ClientData dummy,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj * const objv[]);
+static Tcl_ThreadCreateType PhotoDecodeThreadProc(ClientData clientData);
+static int		TestphotoinstancesObjCmd(ClientData dummy,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj * const objv[]);
 
 /*
  *----------------------------------------------------------------------
@@ -278,6 +298,10 @@ Tktest_Init(
     Tcl_CreateObjCommand(interp, "testphotostringmatch",
             TestPhotoStringMatchCmd, (ClientData) Tk_MainWindow(interp),
             NULL);
+    Tcl_CreateObjCommand(interp, "testphotodecode", TestphotodecodeObjCmd,
+	    NULL, NULL);
+    Tcl_CreateObjCommand(interp, "testphotoinstances",
+	    TestphotoinstancesObjCmd, NULL, NULL);
 
 #if defined(_WIN32)
     Tcl_CreateObjCommand(interp, "testmetrics", TestmetricsObjCmd,
@@ -289,7 +313,13 @@ Tktest_Init(
 	    (ClientData) Tk_MainWindow(interp), NULL);
     Tcl_CreateObjCommand(interp, "testwrapper", TestwrapperObjCmd,
 	    (ClientData) Tk_MainWindow(interp), NULL);
+    Tcl_CreateObjCommand(interp, "testinternatoms", TestinternatomsObjCmd,
+	    (ClientData) Tk_MainWindow(interp), NULL);
 #endif /* _WIN32 */
+#if defined(HAVE_XFT) && !defined(MAC_OSX_TK)
+    Tcl_CreateObjCommand(interp, "testfontconfig", TestfontconfigObjCmd,
+	    NULL, NULL);
+#endif
 
     /*
      * Create test image type.
@@ -2010,6 +2040,112 @@ TestwrapperObjCmd(
     }
     return TCL_OK;
 }
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TestinternatomsObjCmd --
+ *
+ *	This function implements the "testinternatoms" command. It interns
+ *	all the given names with a single call to Tk_InternAtoms, then checks
+ *	each resulting atom against Tk_InternAtom and against the atom the X
+ *	server itself returns for the name.
+ *
+ * Results:
+ *	A standard Tcl result; the result is a list with 1 for each name
+ *	whose atoms agree, 0 otherwise.
+ *
+ * Side effects:
+ *	The names are added to the display's atom cache.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+TestinternatomsObjCmd(
+    ClientData clientData,	/* Main window for application. */
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    Tk_Window tkwin;
+    const char **names;
+    Atom *atoms;
+    Tcl_Obj *resultObj;
+    int i, count;
+
+    if (objc < 3) {
+	Tcl_WrongNumArgs(interp, 1, objv, "window name ?name ...?");
+	return TCL_ERROR;
+    }
+    tkwin = Tk_NameToWindow(interp, Tcl_GetString(objv[1]),
+	    (Tk_Window) clientData);
+    if (tkwin == NULL) {
+	return TCL_ERROR;
+    }
+
+    count = objc - 2;
+    names = (const char **)ckalloc(count * sizeof(char *));
+    atoms = (Atom *)ckalloc(count * sizeof(Atom));
+    for (i = 0; i < count; i++) {
+	names[i] = Tcl_GetString(objv[i + 2]);
+    }
+    Tk_InternAtoms(tkwin, count, names, atoms);
+
+    resultObj = Tcl_NewObj();
+    for (i = 0; i < count; i++) {
+	int same = (atoms[i] != None)
+		&& (atoms[i] == Tk_InternAtom(tkwin, names[i]))
+		&& (atoms[i] == XInternAtom(Tk_Display(tkwin), names[i],
+			False));
+
+	Tcl_ListObjAppendElement(NULL, resultObj, Tcl_NewBooleanObj(same));
+    }
+    ckfree(names);
+    ckfree(atoms);
+    Tcl_SetObjResult(interp, resultObj);
+    return TCL_OK;
+}
+#endif
+
+#if defined(HAVE_XFT) && !defined(MAC_OSX_TK)
+/*
+ *----------------------------------------------------------------------
+ *
+ * TestfontconfigObjCmd --
+ *
+ *	This function implements the "testfontconfig" command. It makes
+ *	fontconfig reload its configuration, the way it does when the font
+ *	configuration files change, so that tests can check that results
+ *	cached for the old configuration are dropped.
+ *
+ * Results:
+ *	A standard Tcl result.
+ *
+ * Side effects:
+ *	fontconfig switches to a newly loaded configuration.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+TestfontconfigObjCmd(
+    TCL_UNUSED(void *),
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    if (objc != 1) {
+	Tcl_WrongNumArgs(interp, 1, objv, NULL);
+	return TCL_ERROR;
+    }
+    if (!FcInitReinitialize()) {
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		"couldn't reload the fontconfig configuration", -1));
+	return TCL_ERROR;
+    }
+    return TCL_OK;
+}
 #endif
 
 /*
@@ -2183,6 +2319,168 @@ TestPhotoStringMatchCmd(
 }
 
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TestphotodecodeObjCmd --
+ *
+ *	This function implements the "testphotodecode" command. It decodes
+ *	image data with Tk_PhotoDecodeBlock on a separate thread, using an
+ *	interpreter of that thread, and puts the result into a photo image.
+ *
+ * Results:
+ *	A standard Tcl result; the result is the decoded width and height.
+ *
+ * Side effects:
+ *	The photo image is changed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+typedef struct {
+    const char *data;		/* Image data, copied into the thread. */
+    const char *format;		/* Format string, or NULL. */
+    Tk_PhotoImageBlock block;	/* Decoded pixels. */
+    int code;			/* Result of Tk_PhotoDecodeBlock. */
+    char *message;		/* Error message from the decoding thread. */
+} PhotoDecodeJob;
+
+static Tcl_ThreadCreateType
+PhotoDecodeThreadProc(
+    ClientData clientData)
+{
+    PhotoDecodeJob *jobPtr = (PhotoDecodeJob *)clientData;
+    Tcl_Interp *interp = Tcl_CreateInterp();
+    Tcl_Obj *dataObj = Tcl_NewStringObj(jobPtr->data, -1);
+    Tcl_Obj *formatObj = NULL;
+
+    Tcl_IncrRefCount(dataObj);
+    if (jobPtr->format != NULL) {
+	formatObj = Tcl_NewStringObj(jobPtr->format, -1);
+	Tcl_IncrRefCount(formatObj);
+    }
+    jobPtr->code = Tk_PhotoDecodeBlock(interp, dataObj, formatObj,
+	    &jobPtr->block);
+    if (jobPtr->code != TCL_OK) {
+	const char *message = Tcl_GetStringResult(interp);
+
+	jobPtr->message = (char *)ckalloc(strlen(message) + 1);
+	strcpy(jobPtr->message, message);
+    }
+    Tcl_DecrRefCount(dataObj);
+    if (formatObj != NULL) {
+	Tcl_DecrRefCount(formatObj);
+    }
+    Tcl_DeleteInterp(interp);
+    Tcl_ExitThread(0);
+    TCL_THREAD_CREATE_RETURN;
+}
+
+static int
+TestphotodecodeObjCmd(
+    TCL_UNUSED(void *),
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    PhotoDecodeJob job;
+    Tk_PhotoHandle handle;
+    Tcl_ThreadId threadId;
+    int code, result;
+
+    if (objc != 3 && objc != 4) {
+	Tcl_WrongNumArgs(interp, 1, objv, "imageName data ?format?");
+	return TCL_ERROR;
+    }
+    handle = Tk_FindPhoto(interp, Tcl_GetString(objv[1]));
+    if (handle == NULL) {
+	Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		"image \"%s\" doesn't exist or is not a photo image",
+		Tcl_GetString(objv[1])));
+	return TCL_ERROR;
+    }
+
+    memset(&job, 0, sizeof(job));
+    job.data = Tcl_GetString(objv[2]);
+    job.format = (objc == 4) ? Tcl_GetString(objv[3]) : NULL;
+    if (Tcl_CreateThread(&threadId, PhotoDecodeThreadProc, &job,
+	    TCL_THREAD_STACK_DEFAULT, TCL_THREAD_JOINABLE) != TCL_OK) {
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(
+		"can't create a thread", -1));
+	return TCL_ERROR;
+    }
+    Tcl_JoinThread(threadId, &result);
+
+    if (job.code != TCL_OK) {
+	Tcl_SetObjResult(interp, Tcl_NewStringObj(job.message, -1));
+	ckfree(job.message);
+	return TCL_ERROR;
+    }
+    code = Tk_PhotoExpand(interp, handle, job.block.width, job.block.height);
+    if (code == TCL_OK) {
+	code = Tk_PhotoPutBlock(interp, handle, &job.block, 0, 0,
+		job.block.width, job.block.height, TK_PHOTO_COMPOSITE_SET);
+    }
+    if (code == TCL_OK) {
+	Tcl_SetObjResult(interp, Tcl_ObjPrintf("%d %d",
+		job.block.width, job.block.height));
+    }
+    Tk_PhotoFreeBlock(&job.block);
+    return code;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TestphotoinstancesObjCmd --
+ *
+ *	This function implements the "testphotoinstances" command. It reports
+ *	the instances of a photo image, including the unused ones that have
+ *	not been freed yet.
+ *
+ * Results:
+ *	A standard Tcl result; the result is a list with the number of widgets
+ *	using each instance, most recently created instance first.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+TestphotoinstancesObjCmd(
+    TCL_UNUSED(void *),
+    Tcl_Interp *interp,		/* Current interpreter. */
+    int objc,			/* Number of arguments. */
+    Tcl_Obj *const objv[])	/* Argument objects. */
+{
+    PhotoModel *modelPtr;
+    PhotoInstance *instancePtr;
+    Tcl_Obj *resultObj;
+
+    if (objc != 2) {
+	Tcl_WrongNumArgs(interp, 1, objv, "imageName");
+	return TCL_ERROR;
+    }
+    modelPtr = (PhotoModel *) Tk_FindPhoto(interp, Tcl_GetString(objv[1]));
+    if (modelPtr == NULL) {
+	Tcl_SetObjResult(interp, Tcl_ObjPrintf(
+		"image \"%s\" doesn't exist or is not a photo image",
+		Tcl_GetString(objv[1])));
+	return TCL_ERROR;
+    }
+
+    resultObj = Tcl_NewObj();
+    for (instancePtr = modelPtr->instancePtr; instancePtr != NULL;
+	    instancePtr = instancePtr->nextPtr) {
+	Tcl_ListObjAppendElement(NULL, resultObj,
+		Tcl_NewWideIntObj((Tcl_WideInt) instancePtr->refCount));
+    }
+    Tcl_SetObjResult(interp, resultObj);
+    return TCL_OK;
+}
+
 
 /*
  * Local Variables:
@@ -95,6 +95,13 @@ typedef struct TkTextEmbWindowClient {
 				 * window. */
     int displayed;		/* Non-zero means that the window has been
 				 * displayed on the screen recently. */
+    int reqWidth, reqHeight;	/* Requested size of the window when it was
+				 * last destroyed because of -ondemand; used
+				 * to measure the line until it is created
+				 * again. */
+    int fromCreate;		/* Non-zero means tkwin was made by the
+				 * -create script of the segment, rather than
+				 * given with -window. */
     struct TkTextSegment *parent;
     struct TkTextEmbWindowClient *next;
 } TkTextEmbWindowClient;
@@ -118,6 +125,9 @@ typedef struct TkTextEmbWindow {
 				 * window, in pixels. */
     int stretch;		/* Should window stretch to fill vertical
 				 * space of line (except for pady)? 0 or 1. */
+    int onDemand;		/* Non-zero means a window made by the create
+				 * script only exists while it is displayed.
+				 * 0 or 1. */
     Tk_OptionTable optionTable;	/* Token representing the configuration
 				 * specifications. */
     TkTextEmbWindowClient *clients;
@@ -830,6 +840,9 @@ typedef struct TkText {
  *				ignored.
  * OPTIONS_FREED		The widget's options have been freed.
  * DESTROYED			The widget is going away.
+ * DISPLAY_LAYOUT		Lines are being laid out to be displayed, as
+ *				opposed to being measured. Embedded windows
+ *				with -ondemand set are only created then.
  */
 
 #define GOT_SELECTION		1
@@ -840,6 +853,7 @@ typedef struct TkText {
 #define NEED_REPICK		0x20
 #define OPTIONS_FREED		0x40
 #define DESTROYED		0x80
+#define DISPLAY_LAYOUT		0x100
 
 /*
  * Records of the following type define segment types in terms of a collection
@@ -1035,11 +1049,15 @@ MODULE_SCOPE void	TkBTreeLinkSegment(TkTextSegment *segPtr,
 			    TkTextIndex *indexPtr);
 MODULE_SCOPE TkTextLine *TkBTreeNextLine(const TkText *textPtr,
 			    TkTextLine *linePtr);
+MODULE_SCOPE TkTextLine *TkBTreeNextMarkLine(const TkText *textPtr,
+			    TkTextLine *linePtr);
 MODULE_SCOPE int	TkBTreeNextTag(TkTextSearch *searchPtr);
 MODULE_SCOPE int	TkBTreeNumPixels(TkTextBTree tree,
 			    const TkText *textPtr);
 MODULE_SCOPE TkTextLine *TkBTreePreviousLine(TkText *textPtr,
 			    TkTextLine *linePtr);
+MODULE_SCOPE TkTextLine *TkBTreePreviousMarkLine(const TkText *textPtr,
+			    TkTextLine *linePtr);
 MODULE_SCOPE int	TkBTreePrevTag(TkTextSearch *searchPtr);
 MODULE_SCOPE void	TkBTreeStartSearch(TkTextIndex *index1Ptr,
 			    TkTextIndex *index2Ptr, TkTextTag *tagPtr,
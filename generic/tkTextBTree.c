@@ -76,6 +76,9 @@ typedef struct Node {
     int *numPixels;		/* Array containing total number of vertical
 				 * display pixels in the subtree rooted here,
 				 * one entry for each peer widget. */
+    int numMarks;		/* Total number of mark segments in the
+				 * subtree rooted here. Lets mark searches
+				 * skip subtrees without marks. */
 } Node;
 
 /*
@@ -94,6 +97,14 @@ typedef struct Node {
 #define MAX_CHILDREN 12
 #define MIN_CHILDREN 6
 
+/*
+ * Whether a segment is a mark (counted in Node.numMarks).
+ */
+
+#define IsMarkSegment(segPtr) \
+    (((segPtr)->typePtr == &tkTextRightMarkType) \
+	    || ((segPtr)->typePtr == &tkTextLeftMarkType))
+
 /*
  * The data structure below defines an entire B-tree. Since text widgets are
  * the only current B-tree clients, 'clients' and 'pixelReferences' are
@@ -153,6 +164,7 @@ static int		AdjustPixelClient(BTree *treePtr, int defaultHeight,
 			    Node *nodePtr, TkTextLine *start, TkTextLine *end,
 			    int useReference, int newPixelReferences,
 			    int *counting);
+static void		ChangeNodeMarkCount(Node *nodePtr, int delta);
 static void		ChangeNodeToggleCount(Node *nodePtr,
 			    TkTextTag *tagPtr, int delta);
 static void		CharCheckProc(TkTextSegment *segPtr,
@@ -168,6 +180,7 @@ static void		DeleteSummaries(Summary *tagPtr);
 static void		DestroyNode(Node *nodePtr);
 static TkTextSegment *	FindTagEnd(TkTextBTree tree, TkTextTag *tagPtr,
 			    TkTextIndex *indexPtr);
+static int		LineHasMarks(TkTextLine *linePtr);
 static void		IncCount(TkTextTag *tagPtr, int inc,
 			    TagInfo *tagInfoPtr);
 static void		Rebalance(BTree *treePtr, Node *nodePtr);
@@ -284,6 +297,7 @@ TkBTreeCreate(
     rootPtr->children.linePtr = linePtr;
     rootPtr->numChildren = 2;
     rootPtr->numLines = 2;
+    rootPtr->numMarks = 0;
 
     /*
      * The tree currently has no registered clients, so all pixel count
@@ -1456,6 +1470,12 @@ TkBTreeDeleteIndexRange(
 	     * prevPtr if the segment has left gravity.
 	     */
 
+	    if (IsMarkSegment(segPtr)
+		    && (curNodePtr != index1Ptr->linePtr->parentPtr)) {
+		ChangeNodeMarkCount(curNodePtr, -1);
+		ChangeNodeMarkCount(index1Ptr->linePtr->parentPtr, 1);
+	    }
+
 	    if (prevPtr == NULL) {
 		segPtr->nextPtr = index1Ptr->linePtr->segPtr;
 		index1Ptr->linePtr->segPtr = segPtr;
@@ -1478,13 +1498,18 @@ TkBTreeDeleteIndexRange(
     if (index1Ptr->linePtr != index2Ptr->linePtr) {
 	TkTextLine *prevLinePtr;
 
+	curNodePtr = index2Ptr->linePtr->parentPtr;
 	for (segPtr = lastPtr; segPtr != NULL;
 		segPtr = segPtr->nextPtr) {
 	    if (segPtr->typePtr->lineChangeProc != NULL) {
 		segPtr->typePtr->lineChangeProc(segPtr, index2Ptr->linePtr);
 	    }
+	    if (IsMarkSegment(segPtr)
+		    && (curNodePtr != index1Ptr->linePtr->parentPtr)) {
+		ChangeNodeMarkCount(curNodePtr, -1);
+		ChangeNodeMarkCount(index1Ptr->linePtr->parentPtr, 1);
+	    }
 	}
-	curNodePtr = index2Ptr->linePtr->parentPtr;
 	for (nodePtr = curNodePtr; nodePtr != NULL;
 		nodePtr = nodePtr->parentPtr) {
 	    nodePtr->numLines--;
@@ -1868,6 +1893,192 @@ TkBTreePreviousLine(
     }
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkBTreeNextMarkLine, TkBTreePreviousMarkLine --
+ *
+ *	Given an existing line in a B-tree, these functions locate the nearest
+ *	following (preceding) line that contains at least one mark segment.
+ *	Subtrees without marks are skipped using the nodes' mark counts, so
+ *	the cost depends on the depth of the tree rather than on the number
+ *	of lines between marks.
+ *
+ * Results:
+ *	The return value is a pointer to the line found, or NULL if there is
+ *	no such line within the lines of textPtr (the whole tree if textPtr is
+ *	NULL).
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+TkTextLine *
+TkBTreeNextMarkLine(
+    const TkText *textPtr,	/* Next line in the context of this client. */
+    TkTextLine *linePtr)	/* Pointer to existing line in B-tree. */
+{
+    Node *nodePtr = linePtr->parentPtr;
+    Node *siblingPtr;
+
+    if (textPtr != NULL && linePtr == textPtr->end) {
+	return NULL;
+    }
+    linePtr = linePtr->nextPtr;
+    while (1) {
+	for ( ; linePtr != NULL; linePtr = linePtr->nextPtr) {
+	    if (LineHasMarks(linePtr)) {
+		goto found;
+	    }
+	}
+
+	/*
+	 * Nothing more under this node. Search up the tree for the next node
+	 * that has marks, then down from it to its first line.
+	 */
+
+	while (1) {
+	    for (siblingPtr = nodePtr->nextPtr; siblingPtr != NULL;
+		    siblingPtr = siblingPtr->nextPtr) {
+		if (siblingPtr->numMarks > 0) {
+		    break;
+		}
+	    }
+	    if (siblingPtr != NULL) {
+		nodePtr = siblingPtr;
+		break;
+	    }
+	    nodePtr = nodePtr->parentPtr;
+	    if (nodePtr == NULL) {
+		return NULL;
+	    }
+	}
+	while (nodePtr->level > 0) {
+	    for (nodePtr = nodePtr->children.nodePtr; nodePtr != NULL;
+		    nodePtr = nodePtr->nextPtr) {
+		if (nodePtr->numMarks > 0) {
+		    break;
+		}
+	    }
+	    if (nodePtr == NULL) {
+		Tcl_Panic("TkBTreeNextMarkLine: bad mark count");
+	    }
+	}
+	linePtr = nodePtr->children.linePtr;
+    }
+
+  found:
+    if (textPtr != NULL && textPtr->end != NULL
+	    && TkBTreeLinesTo(NULL, linePtr)
+	    > TkBTreeLinesTo(NULL, textPtr->end)) {
+	return NULL;
+    }
+    return linePtr;
+}
+
+TkTextLine *
+TkBTreePreviousMarkLine(
+    const TkText *textPtr,	/* Relative to this client of the B-tree. */
+    TkTextLine *linePtr)	/* Pointer to existing line in B-tree. */
+{
+    Node *nodePtr = linePtr->parentPtr;
+    Node *childPtr, *lastPtr;
+    TkTextLine *stopPtr = linePtr, *prevPtr;
+
+    if (textPtr != NULL && linePtr == textPtr->start) {
+	return NULL;
+    }
+    while (1) {
+	prevPtr = NULL;
+	for (linePtr = nodePtr->children.linePtr; linePtr != stopPtr;
+		linePtr = linePtr->nextPtr) {
+	    if (LineHasMarks(linePtr)) {
+		prevPtr = linePtr;
+	    }
+	}
+	if (prevPtr != NULL) {
+	    break;
+	}
+
+	/*
+	 * Nothing earlier under this node. Search up the tree for the
+	 * closest preceding node that has marks, then down from it to its
+	 * last subtree with marks.
+	 */
+
+	while (1) {
+	    if (nodePtr->parentPtr == NULL) {
+		return NULL;
+	    }
+	    lastPtr = NULL;
+	    for (childPtr = nodePtr->parentPtr->children.nodePtr;
+		    childPtr != nodePtr; childPtr = childPtr->nextPtr) {
+		if (childPtr->numMarks > 0) {
+		    lastPtr = childPtr;
+		}
+	    }
+	    if (lastPtr != NULL) {
+		nodePtr = lastPtr;
+		break;
+	    }
+	    nodePtr = nodePtr->parentPtr;
+	}
+	while (nodePtr->level > 0) {
+	    lastPtr = NULL;
+	    for (childPtr = nodePtr->children.nodePtr; childPtr != NULL;
+		    childPtr = childPtr->nextPtr) {
+		if (childPtr->numMarks > 0) {
+		    lastPtr = childPtr;
+		}
+	    }
+	    if (lastPtr == NULL) {
+		Tcl_Panic("TkBTreePreviousMarkLine: bad mark count");
+	    }
+	    nodePtr = lastPtr;
+	}
+	stopPtr = NULL;
+    }
+
+    if (textPtr != NULL && textPtr->start != NULL
+	    && TkBTreeLinesTo(NULL, prevPtr)
+	    < TkBTreeLinesTo(NULL, textPtr->start)) {
+	return NULL;
+    }
+    return prevPtr;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * LineHasMarks --
+ *
+ *	Tell whether a line contains any mark segment.
+ *
+ * Results:
+ *	1 if it does, 0 otherwise.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+LineHasMarks(
+    TkTextLine *linePtr)	/* Line to check. */
+{
+    TkTextSegment *segPtr;
+
+    for (segPtr = linePtr->segPtr; segPtr != NULL; segPtr = segPtr->nextPtr) {
+	if (IsMarkSegment(segPtr)) {
+	    return 1;
+	}
+    }
+    return 0;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -2055,6 +2266,9 @@ TkBTreeLinkSegment(
 	segPtr->nextPtr = prevPtr->nextPtr;
 	prevPtr->nextPtr = segPtr;
     }
+    if (IsMarkSegment(segPtr)) {
+	ChangeNodeMarkCount(indexPtr->linePtr->parentPtr, 1);
+    }
     CleanupLine(indexPtr->linePtr);
     if (tkBTreeDebug) {
 	TkBTreeCheck(indexPtr->tree);
@@ -2105,6 +2319,9 @@ TkBTreeUnlinkSegment(
 	}
 	prevPtr->nextPtr = segPtr->nextPtr;
     }
+    if (IsMarkSegment(segPtr)) {
+	ChangeNodeMarkCount(linePtr->parentPtr, -1);
+    }
     CleanupLine(linePtr);
 }
 
@@ -2261,6 +2478,34 @@ TkBTreeTag(
     return anyChanges;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * ChangeNodeMarkCount --
+ *
+ *	This function increments or decrements the mark count of a node and
+ *	all its ancestors, after a mark segment was added to or removed from
+ *	one of its lines.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The numMarks fields of nodePtr and its ancestors are modified.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+ChangeNodeMarkCount(
+    Node *nodePtr,		/* Node whose line gained or lost a mark. */
+    int delta)			/* Amount to add to the counts. */
+{
+    for ( ; nodePtr != NULL; nodePtr = nodePtr->parentPtr) {
+	nodePtr->numMarks += delta;
+    }
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -3902,7 +4147,7 @@ CheckNodeConsistency(
     Summary *summaryPtr, *summaryPtr2;
     TkTextLine *linePtr;
     TkTextSegment *segPtr;
-    int numChildren, numLines, toggleCount, minChildren, i;
+    int numChildren, numLines, numMarks, toggleCount, minChildren, i;
     int *numPixels;
     int pixels[PIXEL_CLIENTS];
 
@@ -3921,6 +4166,7 @@ CheckNodeConsistency(
 
     numChildren = 0;
     numLines = 0;
+    numMarks = 0;
     if (references > PIXEL_CLIENTS) {
 	numPixels = (int *)ckalloc(sizeof(int) * references);
     } else {
@@ -3944,6 +4190,9 @@ CheckNodeConsistency(
 		if (segPtr->typePtr->checkProc != NULL) {
 		    segPtr->typePtr->checkProc(segPtr, linePtr);
 		}
+		if (IsMarkSegment(segPtr)) {
+		    numMarks++;
+		}
 		if ((segPtr->size == 0) && (!segPtr->typePtr->leftGravity)
 			&& (segPtr->nextPtr != NULL)
 			&& (segPtr->nextPtr->size == 0)
@@ -3991,6 +4240,7 @@ CheckNodeConsistency(
 	    }
 	    numChildren++;
 	    numLines += childNodePtr->numLines;
+	    numMarks += childNodePtr->numMarks;
 	    for (i = 0; i<references; i++) {
 		numPixels[i] += childNodePtr->numPixels[i];
 	    }
@@ -4004,6 +4254,10 @@ CheckNodeConsistency(
 	Tcl_Panic("CheckNodeConsistency: mismatch in numLines (%d %d)",
 		numLines, nodePtr->numLines);
     }
+    if (numMarks != nodePtr->numMarks) {
+	Tcl_Panic("CheckNodeConsistency: mismatch in numMarks (%d %d)",
+		numMarks, nodePtr->numMarks);
+    }
     for (i = 0; i<references; i++) {
 	if (numPixels[i] != nodePtr->numPixels[i]) {
 	    Tcl_Panic("CheckNodeConsistency: mismatch in numPixels (%d %d) for widget (%d)",
@@ -4340,6 +4594,7 @@ RecomputeNodeCounts(
     }
     nodePtr->numChildren = 0;
     nodePtr->numLines = 0;
+    nodePtr->numMarks = 0;
     for (ref = 0; ref<treePtr->pixelReferences; ref++) {
 	nodePtr->numPixels[ref] = 0;
     }
@@ -4360,6 +4615,9 @@ RecomputeNodeCounts(
 	    linePtr->parentPtr = nodePtr;
 	    for (segPtr = linePtr->segPtr; segPtr != NULL;
 		    segPtr = segPtr->nextPtr) {
+		if (IsMarkSegment(segPtr)) {
+		    nodePtr->numMarks++;
+		}
 		if (((segPtr->typePtr != &tkTextToggleOnType)
 			&& (segPtr->typePtr != &tkTextToggleOffType))
 			|| !(segPtr->body.toggle.inNodeCounts)) {
@@ -4388,6 +4646,7 @@ RecomputeNodeCounts(
 		childPtr = childPtr->nextPtr) {
 	    nodePtr->numChildren++;
 	    nodePtr->numLines += childPtr->numLines;
+	    nodePtr->numMarks += childPtr->numMarks;
 	    for (ref = 0; ref<treePtr->pixelReferences; ref++) {
 		nodePtr->numPixels[ref] += childPtr->numPixels[ref];
 	    }
@@ -537,6 +537,10 @@ static int lineHeightsRecalculated;
 static void		AdjustForTab(TkText *textPtr,
 			    TkTextTabArray *tabArrayPtr, int index,
 			    TkTextDispChunk *chunkPtr);
+static int		CopyPeerLineMetrics(TkText *textPtr,
+			    TkTextLine *linePtr);
+static int		PrevElideToggle(TkText *textPtr,
+			    TkTextIndex *indexPtr, TkTextIndex *togglePtr);
 static void		CharBboxProc(TkText *textPtr,
 			    TkTextDispChunk *chunkPtr, int index, int y,
 			    int lineHeight, int baseline, int *xPtr,
@@ -1914,7 +1918,9 @@ UpdateDisplayInfo(
 		TkTextPrintIndex(textPtr, &index, string);
 		LOG("tk_textRelayout", string);
 	    }
+	    textPtr->flags |= DISPLAY_LAYOUT;
 	    newPtr = LayoutDLine(textPtr, &index);
+	    textPtr->flags &= ~DISPLAY_LAYOUT;
 	    if (prevPtr == NULL) {
 		dInfoPtr->dLinePtr = newPtr;
 	    } else {
@@ -2119,7 +2125,9 @@ UpdateDisplayInfo(
 		lowestPtr = NULL;
 
 		do {
+		    textPtr->flags |= DISPLAY_LAYOUT;
 		    dlPtr = LayoutDLine(textPtr, &index);
+		    textPtr->flags &= ~DISPLAY_LAYOUT;
 		    pixelHeight += dlPtr->height;
 		    dlPtr->nextPtr = lowestPtr;
 		    lowestPtr = dlPtr;
@@ -3280,6 +3288,14 @@ TkTextUpdateLineMetrics(
 		 * to do here.
 		 */
 
+	    } else if (CopyPeerLineMetrics(textPtr, linePtr)) {
+
+		/*
+		 * A peer with the same layout configuration already knows
+		 * this line's height; we took it from there.
+		 */
+
+		count++;
 	    } else if (doThisMuch == -1) {
 		count += 8 * TkTextUpdateOneLine(textPtr, linePtr, 0,NULL,0);
 	    } else {
@@ -3568,6 +3584,71 @@ TextInvalidateLineMetrics(
     GenerateWidgetViewSyncEvent(textPtr, 0);
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * PrevElideToggle --
+ *
+ *	Finds the closest toggle, before indexPtr, of any tag that has an
+ *	-elide option. The searches use the tag summaries of the B-tree, so
+ *	subtrees without toggles of such tags are skipped as a whole.
+ *
+ * Results:
+ *	Returns 1 and fills in *togglePtr if such a toggle exists within the
+ *	lines shown by the widget, 0 otherwise.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+PrevElideToggle(
+    TkText *textPtr,		/* Widget record for text widget. */
+    TkTextIndex *indexPtr,	/* Toggles at this position are ignored. */
+    TkTextIndex *togglePtr)	/* Filled in with the toggle's position. */
+{
+    TkSharedText *sharedTextPtr = textPtr->sharedTextPtr;
+    TkTextIndex startIndex;
+    TkTextSearch search;
+    Tcl_HashSearch hSearch;
+    Tcl_HashEntry *hPtr;
+    TkText *peerPtr;
+    TkTextTag *tagPtr;
+    int found = 0;
+
+    TkTextMakeByteIndex(sharedTextPtr->tree, textPtr, 0, 0, &startIndex);
+
+    /*
+     * Each peer's "sel" tag isn't in the tag table, but it may elide text
+     * too.
+     */
+
+    hPtr = Tcl_FirstHashEntry(&sharedTextPtr->tagTable, &hSearch);
+    peerPtr = sharedTextPtr->peers;
+    while ((hPtr != NULL) || (peerPtr != NULL)) {
+	if (hPtr != NULL) {
+	    tagPtr = (TkTextTag *)Tcl_GetHashValue(hPtr);
+	    hPtr = Tcl_NextHashEntry(&hSearch);
+	} else {
+	    tagPtr = peerPtr->selTagPtr;
+	    peerPtr = peerPtr->next;
+	}
+	if ((tagPtr == NULL) || (tagPtr->elideString == NULL)
+		|| (tagPtr->toggleCount == 0)) {
+	    continue;
+	}
+	TkBTreeStartSearchBack(indexPtr, &startIndex, tagPtr, &search);
+	if (TkBTreePrevTag(&search) && (!found
+		|| TkTextIndexCmp(&search.curIndex, togglePtr) > 0)) {
+	    *togglePtr = search.curIndex;
+	    found = 1;
+	}
+    }
+    return found;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -3654,9 +3735,16 @@ TkTextFindDisplayLineEnd(
 	/*
 	 * indexPtr's logical line is actually merged with the previous
 	 * logical line whose eol is elided. Continue searching back to get a
-	 * real line start.
+	 * real line start. The elide state can't change before the previous
+	 * toggle of an elide tag, so all lines from the one holding that
+	 * toggle onwards are merged too: skip straight to it rather than
+	 * testing every line end of a large elided region.
 	 */
 
+	if (PrevElideToggle(textPtr, &index, &endOfLastLine) == 0) {
+	    TkTextMakeByteIndex(textPtr->sharedTextPtr->tree, textPtr, 0, 0,
+		    &endOfLastLine);
+	}
 	index = endOfLastLine;
 	index.byteIndex = 0;
     }
@@ -3918,6 +4006,101 @@ TkTextIndexYPixels(
     }
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * CopyPeerLineMetrics --
+ *
+ *	Peers of a text widget that are configured identically (same usable
+ *	width, default font, spacing, tabs and wrap mode) lay out every line
+ *	identically. When such a peer already holds an up to date height for
+ *	linePtr, this function copies it instead of laying the line out
+ *	again, so that e.g. split views of one large document only compute
+ *	the metrics once.
+ *
+ *	Sharing is not attempted when the text holds embedded windows (each
+ *	peer has its own windows, whose sizes may differ) or when a peer's
+ *	"sel" tag, which is widget-specific, affects line geometry.
+ *
+ * Results:
+ *	1 if the line's height was taken from a peer, 0 if it still needs to
+ *	be computed.
+ *
+ * Side effects:
+ *	The line's pixel height and metric epoch for textPtr may be updated,
+ *	and a partial calculation of the line's height is cancelled.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+CopyPeerLineMetrics(
+    TkText *textPtr,		/* Widget record for text widget. */
+    TkTextLine *linePtr)	/* The line whose height is needed. */
+{
+    TextDInfo *dInfoPtr = textPtr->dInfoPtr;
+    TkText *peerPtr;
+    TextDInfo *peerDInfoPtr;
+    int height;
+
+    if ((textPtr->sharedTextPtr->peers->next == NULL)
+	    || (textPtr->sharedTextPtr->windowTable.numEntries > 0)
+	    || textPtr->selTagPtr->affectsDisplayGeometry) {
+	return 0;
+    }
+    for (peerPtr = textPtr->sharedTextPtr->peers; peerPtr != NULL;
+	    peerPtr = peerPtr->next) {
+	peerDInfoPtr = peerPtr->dInfoPtr;
+	if ((peerPtr == textPtr) || (peerDInfoPtr == NULL)
+		|| (TkBTreeLinePixelEpoch(peerPtr, linePtr)
+			!= peerDInfoPtr->lineMetricUpdateEpoch)
+		|| peerPtr->selTagPtr->affectsDisplayGeometry
+		|| (peerDInfoPtr->maxX - peerDInfoPtr->x
+			!= dInfoPtr->maxX - dInfoPtr->x)
+		|| (peerPtr->tkfont != textPtr->tkfont)
+		|| (peerPtr->wrapMode != textPtr->wrapMode)
+		|| (peerPtr->spacing1 != textPtr->spacing1)
+		|| (peerPtr->spacing2 != textPtr->spacing2)
+		|| (peerPtr->spacing3 != textPtr->spacing3)
+		|| (peerPtr->tabStyle != textPtr->tabStyle)) {
+	    continue;
+	}
+	if ((peerPtr->tabOptionPtr != textPtr->tabOptionPtr)
+		&& ((peerPtr->tabOptionPtr == NULL)
+		|| (textPtr->tabOptionPtr == NULL)
+		|| strcmp(Tcl_GetString(peerPtr->tabOptionPtr),
+			Tcl_GetString(textPtr->tabOptionPtr)) != 0)) {
+	    continue;
+	}
+
+	/*
+	 * Mark the line up to date first, as TkTextUpdateOneLine does, then
+	 * store the height (TkBTreeAdjustPixelHeight also updates the node
+	 * totals).
+	 */
+
+	height = TkBTreeLinePixelCount(peerPtr, linePtr);
+	TkBTreeLinePixelEpoch(textPtr, linePtr) =
+		dInfoPtr->lineMetricUpdateEpoch;
+	if (TkBTreeLinePixelCount(textPtr, linePtr) != height) {
+	    TkBTreeAdjustPixelHeight(textPtr, linePtr, height, 0);
+	}
+
+	/*
+	 * If we were part way through laying out this (long, wrapped) line
+	 * ourselves, cancel that partial calculation, as TkTextUpdateOneLine
+	 * does once it completes a line. Otherwise the asynchronous update
+	 * would never consider itself finished.
+	 */
+
+	if (dInfoPtr->metricIndex.linePtr == linePtr) {
+	    dInfoPtr->metricEpoch = -1;
+	}
+	return 1;
+    }
+    return 0;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -864,7 +864,7 @@ MarkFindNext(
 		}
 	    }
 	}
-	index.linePtr = TkBTreeNextLine(textPtr, index.linePtr);
+	index.linePtr = TkBTreeNextMarkLine(textPtr, index.linePtr);
 	if (index.linePtr == NULL) {
 	    return TCL_OK;
 	}
@@ -967,7 +967,7 @@ MarkFindPrev(
 		return TCL_OK;
 	    }
 	}
-	index.linePtr = TkBTreePreviousLine(textPtr, index.linePtr);
+	index.linePtr = TkBTreePreviousMarkLine(textPtr, index.linePtr);
 	if (index.linePtr == NULL) {
 	    return TCL_OK;
 	}
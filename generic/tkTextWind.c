@@ -53,6 +53,7 @@ static void		EmbWinBboxProc(TkText *textPtr,
 static int		EmbWinConfigure(TkText *textPtr, TkTextSegment *ewPtr,
 			    int objc, Tcl_Obj *const objv[]);
 static void		EmbWinDelayedUnmap(ClientData clientData);
+static void		EmbWinDestroyHidden(TkTextEmbWindowClient *client);
 static int		EmbWinDeleteProc(TkTextSegment *segPtr,
 			    TkTextLine *linePtr, int treeGone);
 static int		EmbWinLayoutProc(TkText *textPtr,
@@ -103,6 +104,8 @@ static const Tk_OptionSpec optionSpecs[] = {
 	0, alignStrings, 0},
     {TK_OPTION_STRING, "-create", NULL, NULL,
 	NULL, TCL_INDEX_NONE, offsetof(TkTextEmbWindow, create), TK_OPTION_NULL_OK, 0, 0},
+    {TK_OPTION_BOOLEAN, "-ondemand", NULL, NULL,
+	"0", TCL_INDEX_NONE, offsetof(TkTextEmbWindow, onDemand), 0, 0, 0},
     {TK_OPTION_PIXELS, "-padx", NULL, NULL,
 	"0", TCL_INDEX_NONE, offsetof(TkTextEmbWindow, padX), 0, 0, 0},
     {TK_OPTION_PIXELS, "-pady", NULL, NULL,
@@ -306,6 +309,9 @@ TkTextWindowCmd(
 	client->tkwin = NULL;
 	client->chunkCount = 0;
 	client->displayed = 0;
+	client->reqWidth = 0;
+	client->reqHeight = 0;
+	client->fromCreate = 0;
 	client->parent = ewPtr;
 	ewPtr->body.ew.clients = client;
 
@@ -471,10 +477,14 @@ EmbWinConfigure(
 		client->tkwin = NULL;
 		client->chunkCount = 0;
 		client->displayed = 0;
+		client->reqWidth = 0;
+		client->reqHeight = 0;
+		client->fromCreate = 0;
 		client->parent = ewPtr;
 		ewPtr->body.ew.clients = client;
 	    }
 	    client->tkwin = ewPtr->body.ew.tkwin;
+	    client->fromCreate = 0;
 
 	    /*
 	     * Take over geometry management for the window, plus create an
@@ -847,7 +857,9 @@ EmbWinLayoutProc(
 	ewPtr->body.ew.tkwin = client->tkwin;
     }
 
-    if ((ewPtr->body.ew.tkwin == NULL) && (ewPtr->body.ew.create != NULL)) {
+    if ((ewPtr->body.ew.tkwin == NULL) && (ewPtr->body.ew.create != NULL)
+	    && (!ewPtr->body.ew.onDemand
+		    || (textPtr->flags & DISPLAY_LAYOUT))) {
 	int code, isNew;
 	Tk_Window ancestor;
 	Tcl_HashEntry *hPtr;
@@ -960,11 +972,15 @@ EmbWinLayoutProc(
 	    client->tkwin = NULL;
 	    client->chunkCount = 0;
 	    client->displayed = 0;
+	    client->reqWidth = 0;
+	    client->reqHeight = 0;
+	    client->fromCreate = 0;
 	    client->parent = ewPtr;
 	    ewPtr->body.ew.clients = client;
 	}
 
 	client->tkwin = ewPtr->body.ew.tkwin;
+	client->fromCreate = 1;
 	Tk_ManageGeometry(client->tkwin, &textGeomType, client);
 	Tk_CreateEventHandler(client->tkwin, StructureNotifyMask,
 		EmbWinStructureProc, client);
@@ -986,12 +1002,21 @@ EmbWinLayoutProc(
      */
 
   gotWindow:
-    if (ewPtr->body.ew.tkwin == NULL) {
-	width = 0;
-	height = 0;
-    } else {
+    if (ewPtr->body.ew.tkwin != NULL) {
 	width = Tk_ReqWidth(ewPtr->body.ew.tkwin) + 2*ewPtr->body.ew.padX;
 	height = Tk_ReqHeight(ewPtr->body.ew.tkwin) + 2*ewPtr->body.ew.padY;
+    } else if ((client != NULL) && ewPtr->body.ew.onDemand
+	    && !(textPtr->flags & DISPLAY_LAYOUT)) {
+	/*
+	 * The line is only being measured and the window was destroyed when
+	 * it was last scrolled out of view: use the size it had then.
+	 */
+
+	width = client->reqWidth + 2*ewPtr->body.ew.padX;
+	height = client->reqHeight + 2*ewPtr->body.ew.padY;
+    } else {
+	width = 0;
+	height = 0;
     }
     if ((width > (maxX - chunkPtr->x))
 	    && !noCharsYet && (textPtr->wrapMode != TEXT_WRAPMODE_NONE)) {
@@ -1303,7 +1328,10 @@ EmbWinDelayedUnmap(
     TkTextEmbWindowClient *client = (TkTextEmbWindowClient *)clientData;
 
     if (!client->displayed && (client->tkwin != NULL)) {
-	if (client->textPtr->tkwin != Tk_Parent(client->tkwin)) {
+	if (client->fromCreate && client->parent->body.ew.onDemand
+		&& (client->parent->body.ew.create != NULL)) {
+	    EmbWinDestroyHidden(client);
+	} else if (client->textPtr->tkwin != Tk_Parent(client->tkwin)) {
 	    Tk_UnmaintainGeometry(client->tkwin, client->textPtr->tkwin);
 	} else {
 	    Tk_UnmapWindow(client->tkwin);
@@ -1311,6 +1339,57 @@ EmbWinDelayedUnmap(
     }
 }
 
+/*
+ *--------------------------------------------------------------
+ *
+ * EmbWinDestroyHidden --
+ *
+ *	This function destroys an embedded window that was made by its
+ *	-create script and has -ondemand set, once it is no longer displayed.
+ *	The client record is kept, together with the window's requested size,
+ *	so that the line can still be measured; the -create script makes a
+ *	new window when the line is displayed again.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The window is destroyed.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+EmbWinDestroyHidden(
+    TkTextEmbWindowClient *client)
+				/* Client whose window is to be destroyed. */
+{
+    TkTextSegment *ewPtr = client->parent;
+    Tk_Window tkwin = client->tkwin;
+    Tcl_HashEntry *hPtr;
+
+    client->reqWidth = Tk_ReqWidth(tkwin);
+    client->reqHeight = Tk_ReqHeight(tkwin);
+    hPtr = Tcl_FindHashEntry(&ewPtr->body.ew.sharedTextPtr->windowTable,
+	    Tk_PathName(tkwin));
+    if (hPtr != NULL) {
+	Tcl_DeleteHashEntry(hPtr);
+    }
+
+    /*
+     * Remove the event handler first, so that EmbWinStructureProc doesn't
+     * invalidate the line: its size doesn't change.
+     */
+
+    Tk_DeleteEventHandler(tkwin, StructureNotifyMask, EmbWinStructureProc,
+	    client);
+    client->tkwin = NULL;
+    if (ewPtr->body.ew.tkwin == tkwin) {
+	ewPtr->body.ew.tkwin = NULL;
+    }
+    Tk_DestroyWindow(tkwin);
+}
+
 /*
  *--------------------------------------------------------------
  *
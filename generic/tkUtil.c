@@ -1313,6 +1313,32 @@ TkUtfPrev(
 
 #endif
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkGetMicroseconds --
+ *
+ *	Returns the current time in microseconds, for measuring how long
+ *	something takes.
+ *
+ * Results:
+ *	The current time, in microseconds since the epoch.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+Tcl_WideInt
+TkGetMicroseconds(void)
+{
+    Tcl_Time now;
+
+    Tcl_GetTime(&now);
+    return (Tcl_WideInt) now.sec * 1000000 + now.usec;
+}
+
 #if TCL_MAJOR_VERSION > 8
 unsigned char *
 TkGetByteArrayFromObj(
@@ -338,6 +338,7 @@ CreateTopLevelWindow(
 	Tk_CreatePhotoImageFormat(&tkImgFmtGIF);
 	Tk_CreatePhotoImageFormat(&tkImgFmtPNG);
 	Tk_CreatePhotoImageFormat(&tkImgFmtPPM);
+	Tk_CreatePhotoImageFormat(&tkImgFmtRaw);
 	Tk_CreatePhotoImageFormat(&tkImgFmtSVGnano);
     }
 
@@ -832,6 +833,7 @@ TkCreateMainWindow(
     TkWindow *winPtr;
     const TkCmd *cmdPtr;
     ClientData clientData;
+    Tcl_WideInt startTime, displayTime;
     ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
 	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
 
@@ -848,11 +850,13 @@ TkCreateMainWindow(
      * Create the basic TkWindow structure.
      */
 
+    startTime = TkGetMicroseconds();
     tkwin = CreateTopLevelWindow(interp, NULL, baseName,
 	    screenName, /* flags */ 0);
     if (tkwin == NULL) {
 	return NULL;
     }
+    displayTime = TkGetMicroseconds() - startTime;
 
     /*
      * Create the TkMainInfo structure for this application, and set up
@@ -866,9 +870,13 @@ TkCreateMainWindow(
     mainPtr->interp = interp;
     Tcl_InitHashTable(&mainPtr->nameTable, TCL_STRING_KEYS);
     mainPtr->deletionEpoch = 0l;
+    memset(mainPtr->startupTimes, 0, sizeof(mainPtr->startupTimes));
+    mainPtr->startupTimes[TK_STARTUP_DISPLAY] = displayTime;
     TkEventInit();
     TkBindInit(mainPtr);
+    startTime = TkGetMicroseconds();
     TkFontPkgInit(mainPtr);
+    mainPtr->startupTimes[TK_STARTUP_FONTS] = TkGetMicroseconds() - startTime;
     TkStylePkgInit(mainPtr);
     mainPtr->tlFocusPtr = NULL;
     mainPtr->displayFocusPtr = NULL;
@@ -3019,6 +3027,8 @@ Initialize(
     ThreadSpecificData *tsdPtr;
     Tcl_Obj *value = NULL;
     Tcl_Obj *cmd;
+    Tcl_WideInt startTime, scriptTime;
+    TkMainInfo *mainPtr;
 
     Tcl_Obj *nameObj = NULL;
     Tcl_Obj *classObj = NULL;
@@ -3055,6 +3065,7 @@ Initialize(
     if (Tcl_InitStubs(interp, "8.6-", 0) == NULL) {
 	return TCL_ERROR;
     }
+    startTime = TkGetMicroseconds();
 
     /*
      * TIP #59: Make embedded configuration information available.
@@ -3329,6 +3340,7 @@ Initialize(
 	 * an alternate [tkInit] command before calling Tk_Init().
 	 */
 
+	scriptTime = TkGetMicroseconds();
 	code = Tcl_EvalEx(interp,
 "if {[namespace which -command tkInit] eq \"\"} {\n\
   proc tkInit {} {\n\
@@ -3338,6 +3350,19 @@ Initialize(
   }\n\
 }\n\
 tkInit", -1, TCL_EVAL_GLOBAL);
+
+	/*
+	 * Record how long startup took for [tk startupprofile]. The library
+	 * scripts may have destroyed the main window already.
+	 */
+
+	if (Tk_MainWindow(interp) != NULL) {
+	    mainPtr = ((TkWindow *) Tk_MainWindow(interp))->mainPtr;
+	    mainPtr->startupTimes[TK_STARTUP_SCRIPTS] =
+		    TkGetMicroseconds() - scriptTime;
+	    mainPtr->startupTimes[TK_STARTUP_TOTAL] =
+		    TkGetMicroseconds() - startTime;
+	}
     }
     if (code == TCL_OK) {
 	/*
@@ -288,8 +288,13 @@ static void EntryInitStyleData(Entry *entryPtr, EntryStyleData *es)
  * 	Return a malloc'ed string consisting of 'numChars' copies
  * 	of (the first character in the string) 'showChar'.
  * 	Used to compute the displayString if -show is non-NULL.
+ *
+ * 	If 'oldString' is not NULL it must be a previous result for
+ * 	the same 'showChar' with 'oldChars' characters; it is resized
+ * 	in place, so only the characters past 'oldChars' are filled in.
  */
-static char *EntryDisplayString(const char *showChar, int numChars)
+static char *EntryDisplayString(
+    const char *showChar, TkSizeT numChars, char *oldString, TkSizeT oldChars)
 {
     char *displayString, *p;
     int size;
@@ -298,8 +303,13 @@ static char *EntryDisplayString(const char *showChar, int numChars)
 
     TkUtfToUniChar(showChar, &ch);
     size = TkUniCharToUtf(ch, buf);
-    p = displayString = (char *)ckalloc(numChars * size + 1);
+    if (oldString == NULL || oldChars > numChars) {
+	oldChars = oldString ? numChars : 0;
+    }
+    displayString = (char *)ckrealloc(oldString, numChars * size + 1);
 
+    p = displayString + oldChars * size;
+    numChars -= oldChars;
     while (numChars--) {
 	memcpy(p, buf, size);
 	p += size;
@@ -736,32 +746,49 @@ EntryStoreValue(Entry *entryPtr, const char *value)
     size_t numBytes = strlen(value);
     TkSizeT numChars = Tcl_NumUtfChars(value, numBytes);
 
+    char *oldDisplayString = NULL;
+
     if (entryPtr->core.flags & VALIDATING)
 	entryPtr->core.flags |= VALIDATION_SET_VALUE;
 
+    /* Nothing to do if the value did not change, e.g. when the
+     * -textvariable is set to the value it already has:
+     */
+    if (numBytes == (size_t)entryPtr->entry.numBytes
+	    && memcmp(value, entryPtr->entry.string, numBytes) == 0) {
+	return;
+    }
+
     /* Make sure all indices remain in bounds:
      */
     if (numChars < entryPtr->entry.numChars)
 	AdjustIndices(entryPtr, numChars, numChars - entryPtr->entry.numChars);
 
-    /* Free old value:
+    /* Free old value. A masked displayString is kept, since it
+     * only needs to be resized for the new value:
      */
     if (entryPtr->entry.displayString != entryPtr->entry.string)
-	ckfree(entryPtr->entry.displayString);
+	oldDisplayString = entryPtr->entry.displayString;
     ckfree(entryPtr->entry.string);
 
     /* Store new value:
      */
+    entryPtr->entry.displayString
+	= entryPtr->entry.showChar
+	? EntryDisplayString(entryPtr->entry.showChar, numChars,
+		oldDisplayString, entryPtr->entry.numChars)
+	: NULL
+	;
+    if (entryPtr->entry.displayString == NULL && oldDisplayString) {
+	ckfree(oldDisplayString);
+    }
+
     entryPtr->entry.string = (char *)ckalloc(numBytes + 1);
     strcpy(entryPtr->entry.string, value);
     entryPtr->entry.numBytes = numBytes;
     entryPtr->entry.numChars = numChars;
-
-    entryPtr->entry.displayString
-	= entryPtr->entry.showChar
-	? EntryDisplayString(entryPtr->entry.showChar, numChars)
-	: entryPtr->entry.string
-	;
+    if (entryPtr->entry.displayString == NULL)
+	entryPtr->entry.displayString = entryPtr->entry.string;
 
     /* Update layout, schedule redisplay:
      */
@@ -1053,7 +1080,8 @@ static int EntryConfigure(Tcl_Interp *interp, void *recordPtr, int mask)
 
     entryPtr->entry.displayString
 	= entryPtr->entry.showChar
-	? EntryDisplayString(entryPtr->entry.showChar, entryPtr->entry.numChars)
+	? EntryDisplayString(entryPtr->entry.showChar, entryPtr->entry.numChars,
+		NULL, 0)
 	: entryPtr->entry.string
 	;
 
@@ -606,15 +606,76 @@ static Ttk_Theme LookupTheme(
     return (Ttk_Theme)Tcl_GetHashValue(entryPtr);
 }
 
+/*
+ * LoadTheme --
+ *	Like LookupTheme, but first evaluates the settings of a built-in
+ *	theme if they have been deferred. ttk.tcl sources the scripts of
+ *	the classic, alt and clam themes at startup, but only records their
+ *	[ttk::style theme settings] scripts in the ::ttk::DeferredThemes
+ *	array (see DeferThemeSettings).
+ */
+
+static Ttk_Theme LoadTheme(
+    Tcl_Interp *interp,		/* where to leave error messages */
+    StylePackageData *pkgPtr,	/* style package record */
+    const char *name)		/* theme name */
+{
+    Tcl_Obj *cmdObj[2];
+    int status;
+
+    if (Tcl_GetVar2Ex(interp, "::ttk::DeferredThemes", name,
+	    TCL_GLOBAL_ONLY) != NULL) {
+	cmdObj[0] = Tcl_NewStringObj("::ttk::LoadTheme", -1);
+	cmdObj[1] = Tcl_NewStringObj(name, -1);
+	Tcl_IncrRefCount(cmdObj[0]);
+	Tcl_IncrRefCount(cmdObj[1]);
+	status = Tcl_EvalObjv(interp, 2, cmdObj, TCL_EVAL_GLOBAL);
+	Tcl_DecrRefCount(cmdObj[0]);
+	Tcl_DecrRefCount(cmdObj[1]);
+	if (status != TCL_OK) {
+	    return NULL;
+	}
+    }
+    return LookupTheme(interp, pkgPtr, name);
+}
+
+/*
+ * DeferThemeSettings --
+ *	While ttk.tcl sources the scripts of the built-in themes whose
+ *	settings are deferred (::ttk::DeferringThemes is set), records a
+ *	[ttk::style theme settings] script for such a theme, together with
+ *	the namespace it is evaluated in, instead of evaluating it.
+ *	Returns 1 if the script was recorded, 0 if it must be evaluated now.
+ */
+
+static int DeferThemeSettings(
+    Tcl_Interp *interp,		/* interpreter */
+    const char *name,		/* theme name */
+    Tcl_Obj *scriptObj)		/* settings script */
+{
+    int flags = TCL_GLOBAL_ONLY|TCL_APPEND_VALUE|TCL_LIST_ELEMENT;
+
+    if (Tcl_GetVar2Ex(interp, "::ttk::DeferringThemes", NULL,
+	    TCL_GLOBAL_ONLY) == NULL
+	    || Tcl_GetVar2Ex(interp, "::ttk::DeferredThemes", name,
+	    TCL_GLOBAL_ONLY) == NULL) {
+	return 0;
+    }
+    Tcl_SetVar2Ex(interp, "::ttk::DeferredThemes", name, Tcl_NewStringObj(
+	    Tcl_GetCurrentNamespace(interp)->fullName, -1), flags);
+    Tcl_SetVar2Ex(interp, "::ttk::DeferredThemes", name, scriptObj, flags);
+    return 1;
+}
+
 /*
  * Ttk_GetTheme --
- *	Public interface to LookupTheme.
+ *	Public interface to LoadTheme.
  */
 Ttk_Theme Ttk_GetTheme(Tcl_Interp *interp, const char *themeName)
 {
     StylePackageData *pkgPtr = GetStylePackageData(interp);
 
-    return LookupTheme(interp, pkgPtr, themeName);
+    return LoadTheme(interp, pkgPtr, themeName);
 }
 
 Ttk_Theme Ttk_GetCurrentTheme(Tcl_Interp *interp)
@@ -1406,7 +1467,7 @@ static int StyleThemeCreateCmd(
 
 	switch (option) {
 	    case OP_PARENT:
-		parentTheme = LookupTheme(
+		parentTheme = LoadTheme(
 		    interp, pkgPtr, Tcl_GetString(objv[i+1]));
 		if (!parentTheme)
 		    return TCL_ERROR;
@@ -1474,7 +1535,10 @@ StyleThemeSettingsCmd(
 	return TCL_ERROR;
     }
 
-    newTheme = LookupTheme(interp, pkgPtr, Tcl_GetString(objv[3]));
+    if (DeferThemeSettings(interp, Tcl_GetString(objv[3]), objv[4])) {
+	return TCL_OK;
+    }
+    newTheme = LoadTheme(interp, pkgPtr, Tcl_GetString(objv[3]));
     if (!newTheme)
 	return TCL_ERROR;
 
@@ -1634,7 +1698,7 @@ StyleThemeUseCmd(
 	return StyleThemeCurrentCmd(clientData, interp, objc, objv);
     }
 
-    theme = LookupTheme(interp, pkgPtr, Tcl_GetString(objv[3]));
+    theme = LoadTheme(interp, pkgPtr, Tcl_GetString(objv[3]));
     if (!theme) {
 	return TCL_ERROR;
     }
@@ -333,7 +333,13 @@ proc ttk::combobox::ConfigureListbox {cb} {
     if {$current < 0} {
 	set current 0 		;# no current entry, highlight first one
     }
-    set Values($cb) $values
+    # Only touch the -listvariable when the values actually changed:
+    # every write makes the listbox re-read and re-measure the whole list,
+    # which is slow for long lists that are posted over and over again.
+    #
+    if {![info exists Values($cb)] || $Values($cb) ne $values} {
+	set Values($cb) $values
+    }
     $popdown.l selection clear 0 end
     $popdown.l selection set $current
     $popdown.l activate $current
@@ -118,8 +118,16 @@ bind TLabel <<Invoke>>		{ tk::TabToWindow [tk_focusNext %W] }
 
 ### Load settings for built-in themes:
 #
+# The scripts of the portable themes that are only used when asked for
+# (classic, alt, clam) are sourced at startup, so that their namespace
+# variables (e.g. ttk::theme::clam::colors) exist, but their
+# [ttk::style theme settings] scripts are only recorded in DeferredThemes,
+# as a list of namespaces and scripts. [ttk::LoadTheme] evaluates them when
+# [ttk::style theme use|settings|create -parent] first refers to the theme.
+#
 proc ttk::LoadThemes {} {
     variable library
+    variable DeferredThemes
 
     # "default" always present:
     uplevel #0 [list source -encoding utf-8 [file join $library defaults.tcl]]
@@ -133,11 +141,30 @@ proc ttk::LoadThemes {} {
 	xpnative	{xpTheme.tcl vistaTheme.tcl}
 	aqua 		aquaTheme.tcl
     } {
-	if {[lsearch -exact $builtinThemes $theme] >= 0} {
-            foreach script $scripts {
-                uplevel #0 [list source -encoding utf-8 [file join $library $script]]
-            }
+	if {[lsearch -exact $builtinThemes $theme] < 0} {
+	    continue
+	}
+	if {$theme in {classic alt clam}} {
+	    set DeferredThemes($theme) {}
+	    set ::ttk::DeferringThemes 1
 	}
+	foreach script $scripts {
+	    uplevel #0 [list source -encoding utf-8 [file join $library $script]]
+	}
+	unset -nocomplain ::ttk::DeferringThemes
+    }
+}
+
+## ttk::LoadTheme $theme --
+#	Evaluate the deferred settings of the built-in theme $theme.
+#
+proc ttk::LoadTheme {theme} {
+    variable DeferredThemes
+
+    set settings $DeferredThemes($theme)
+    unset DeferredThemes($theme)
+    foreach {ns script} $settings {
+	namespace eval $ns [list ::ttk::style theme settings $theme $script]
     }
 }
 
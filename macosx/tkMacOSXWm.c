@@ -2051,6 +2051,7 @@ WmForgetCmd(
         Tk_ManageGeometry(frameWin, NULL, NULL);
 
 	winPtr->flags &= ~(TK_TOP_HIERARCHY|TK_TOP_LEVEL|TK_HAS_WRAPPER|TK_WIN_MANAGED);
+	TkGrabTreeChanged(winPtr->dispPtr);
 
 	/*
          * Flags (above) must be cleared before calling TkMapTopFrame (below).
@@ -2905,6 +2906,7 @@ WmManageCmd(
 	RemapWindows(winPtr, macWin);
 	winPtr->flags |=
 		(TK_TOP_HIERARCHY|TK_TOP_LEVEL|TK_HAS_WRAPPER|TK_WIN_MANAGED);
+	TkGrabTreeChanged(winPtr->dispPtr);
 	TkMapTopFrame(frameWin);
 	TkWmMapWindow(winPtr);
     } else if (Tk_IsTopLevel(frameWin)) {
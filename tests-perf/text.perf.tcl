@@ -0,0 +1,235 @@
+#!/usr/bin/env wish
+# ------------------------------------------------------------------------
+#
+# text.perf.tcl --
+#
+#	This file provides performance tests for the text widget: insertion
+#	and deletion, tag add and remove, search, layout of a screenful,
+#	scrolling to the end, "count -ypixels" and undo/redo, each run on
+#	generated documents of increasing size. Results are printed as JSON
+#	so that they can be collected and compared between Tk versions.
+#
+#	Usage:
+#
+#	    wish text.perf.tcl ?-lines sizes? ?-repeat n? ?-output file?
+#
+#	-lines	List of document sizes (in lines) to run every test on.
+#		Defaults to "1000 10000 100000"; sizes up to 10000000 work
+#		but need a lot of memory and patience.
+#	-repeat	Number of times each test is run; the fastest run is
+#		reported. Defaults to 3.
+#	-output	File to write the JSON results to. Defaults to stdout.
+#
+# ------------------------------------------------------------------------
+#
+# See the file "license.terms" for information on usage and redistribution
+# of this file.
+#
+
+package require Tk
+
+namespace eval ::textPerf {
+    variable options [dict create \
+	-lines {1000 10000 100000} -repeat 3 -output {}]
+    variable results {}
+}
+
+# ::textPerf::Corpus --
+#
+#	Returns the contents of a generated document with the given number of
+#	lines. The lines vary in length, so that some of them wrap, and
+#	contain a few words that the search and tag tests look for.
+
+proc ::textPerf::Corpus {lines} {
+    set words {alpha beta gamma delta epsilon zeta eta theta iota kappa}
+    set text {}
+    for {set i 0} {$i < $lines} {incr i} {
+	set line "$i:"
+	for {set j 0} {$j <= $i % 23} {incr j} {
+	    append line " " [lindex $words [expr {($i + $j) % 10}]]
+	}
+	append text $line \n
+    }
+    return $text
+}
+
+# ::textPerf::Fresh --
+#
+#	Creates the text widget used by a test, filled with the given corpus,
+#	and brings its display up to date.
+
+proc ::textPerf::Fresh {corpus args} {
+    destroy .t
+    text .t -width 80 -height 40 -wrap word {*}$args
+    pack .t -expand 1 -fill both
+    .t insert end $corpus
+    .t edit reset
+    update
+}
+
+# ::textPerf::Measure --
+#
+#	Runs a test 'repeat' times: 'setup' (not timed), then 'body' (timed).
+#	Records the fastest run, in microseconds, under the given name.
+
+proc ::textPerf::Measure {name lines setup body} {
+    variable options
+    variable results
+
+    set best {}
+    for {set i 0} {$i < [dict get $options -repeat]} {incr i} {
+	uplevel 1 $setup
+	set start [clock microseconds]
+	uplevel 1 $body
+	set usec [expr {[clock microseconds] - $start}]
+	if {$best eq {} || $usec < $best} {
+	    set best $usec
+	}
+    }
+    lappend results [list $name $lines $best]
+    puts stderr [format "%-20s %10d lines %14d usec" $name $lines $best]
+}
+
+# ::textPerf::Run --
+#
+#	Runs every test on a document with the given number of lines.
+
+proc ::textPerf::Run {lines} {
+    set corpus [Corpus $lines]
+    set middle [expr {$lines / 2}]
+
+    Measure insert $lines {
+	destroy .t
+	text .t -width 80 -height 40 -wrap word
+	pack .t -expand 1 -fill both
+	update
+    } {
+	.t insert end $corpus
+    }
+
+    Measure insertlines $lines {
+	Fresh $corpus
+    } {
+	for {set i 0} {$i < 1000} {incr i} {
+	    .t insert $middle.0 "inserted line $i\n"
+	}
+    }
+
+    Measure delete $lines {
+	Fresh $corpus
+    } {
+	.t delete [expr {$lines / 4}].0 [expr {3 * $lines / 4}].0
+    }
+
+    Measure tagadd $lines {
+	Fresh $corpus
+    } {
+	for {set i 1} {$i <= $lines} {incr i 10} {
+	    .t tag add hilite $i.0 $i.end
+	}
+    }
+
+    Measure tagremove $lines {
+	Fresh $corpus
+	for {set i 1} {$i <= $lines} {incr i 10} {
+	    .t tag add hilite $i.0 $i.end
+	}
+    } {
+	.t tag remove hilite 1.0 end
+    }
+
+    Measure search $lines {
+	Fresh $corpus
+    } {
+	.t search -all -count counts -regexp {eta\s+theta} 1.0 end
+    }
+
+    Measure layout $lines {
+	Fresh $corpus
+    } {
+	foreach where {0.1 0.3 0.5 0.7 0.9} {
+	    .t yview moveto $where
+	    update idletasks
+	}
+    }
+
+    Measure scrollend $lines {
+	Fresh $corpus
+    } {
+	.t yview end
+	update idletasks
+    }
+
+    Measure ypixels $lines {
+	Fresh $corpus
+    } {
+	.t sync
+	.t count -ypixels 1.0 end
+    }
+
+    Measure undoredo $lines {
+	Fresh $corpus -undo 1 -autoseparators 1
+	for {set i 0} {$i < 1000} {incr i} {
+	    .t insert $middle.0 "edit $i\n"
+	    .t edit separator
+	}
+    } {
+	while {[.t edit canundo]} {
+	    .t edit undo
+	}
+	while {[.t edit canredo]} {
+	    .t edit redo
+	}
+    }
+    destroy .t
+}
+
+# ::textPerf::Json --
+#
+#	Returns the collected results as a JSON document.
+
+proc ::textPerf::Json {} {
+    variable results
+
+    set entries {}
+    foreach result $results {
+	lassign $result name lines usec
+	lappend entries [format \
+		{    {"test": "%s", "lines": %d, "usec": %d}} \
+		$name $lines $usec]
+    }
+    return [join [list "\{" \
+	    [format {  "tk": "%s",} $::tk_patchLevel] \
+	    [format {  "platform": "%s",} [tk windowingsystem]] \
+	    [format {  "time": %d,} [clock seconds]] \
+	    {  "results": [} \
+	    [join $entries ",\n"] \
+	    {  ]} "\}"] \n]
+}
+
+proc ::textPerf::Main {argv} {
+    variable options
+
+    foreach {option value} $argv {
+	if {![dict exists $options $option]} {
+	    return -code error "bad option \"$option\": must be\
+		    [join [dict keys $options] {, }]"
+	}
+	dict set options $option $value
+    }
+    foreach lines [dict get $options -lines] {
+	Run $lines
+    }
+    if {[dict get $options -output] eq {}} {
+	puts [Json]
+    } else {
+	set f [open [dict get $options -output] w]
+	puts $f [Json]
+	close $f
+    }
+}
+
+if {[info script] eq $::argv0} {
+    ::textPerf::Main $::argv
+    exit
+}
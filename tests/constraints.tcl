@@ -207,10 +207,14 @@ testConstraint testcolor     [llength [info commands testcolor]]
 testConstraint testcursor    [llength [info commands testcursor]]
 testConstraint testembed     [llength [info commands testembed]]
 testConstraint testfont      [llength [info commands testfont]]
+testConstraint testfontconfig [llength [info commands testfontconfig]]
+testConstraint testinternatoms [llength [info commands testinternatoms]]
 testConstraint testmakeexist [llength [info commands testmakeexist]]
 testConstraint testmenubar   [llength [info commands testmenubar]]
 testConstraint testmetrics   [llength [info commands testmetrics]]
 testConstraint testobjconfig [llength [info commands testobjconfig]]
+testConstraint testphotodecode [llength [info commands testphotodecode]]
+testConstraint testphotoinstances [llength [info commands testphotoinstances]]
 testConstraint testsend      [llength [info commands testsend]]
 testConstraint testtext      [llength [info commands testtext]]
 testConstraint testwinevent  [llength [info commands testwinevent]]
@@ -225,6 +225,13 @@ TkpCloseDisplay(
 
     TkWmCleanup(dispPtr);
 
+    TkUnixFontCleanup(dispPtr);
+
+    if (dispPtr->keysymTable != NULL) {
+	ckfree(dispPtr->keysymTable);
+	dispPtr->keysymTable = NULL;
+    }
+
 #ifdef TK_USE_INPUT_METHODS
     if (dispPtr->inputXfs) {
 	XFreeFontSet(dispPtr->display, dispPtr->inputXfs);
@@ -343,6 +343,29 @@ TkpFontPkgInit(
 	Tcl_CreateThreadExitHandler(FontPkgCleanup, NULL);
     }
 }
+
+/*
+ *-------------------------------------------------------------------------
+ *
+ * TkUnixFontCleanup --
+ *
+ *	This function is called when a display is closed, to release any
+ *	font information remembered for it.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	None: the X font code keeps nothing per display.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+void
+TkUnixFontCleanup(
+    TCL_UNUSED(TkDisplay *))	/* The display being closed. */
+{
+}
 
 /*
  *-------------------------------------------------------------------------
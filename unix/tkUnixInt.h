@@ -24,6 +24,8 @@
 
 #include "tkIntPlatDecls.h"
 
+MODULE_SCOPE void	TkUnixFontCleanup(TkDisplay *dispPtr);
+
 #endif /* _TKUNIXINT */
 
 /*
@@ -17,6 +17,15 @@
 #include <X11/XKBlib.h>
 #undef XkbOpenDisplay
 
+/*
+ * The keysym table in TkDisplay holds four levels (unshifted, shifted, mode
+ * switch, shifted mode switch) for each of the 256 possible X11 keycodes.
+ */
+
+#define KEYSYM_TABLE_SIZE	(256 * 4 * sizeof(KeySym))
+#define LookupKeysym(dispPtr, keycode, index) \
+    ((dispPtr)->keysymTable[((keycode) & 0xff) * 4 + (index)])
+
 /*
  * Prototypes for local functions defined in this file:
  */
@@ -359,8 +368,7 @@ TkpGetKeySym(
 	    && (eventPtr->xkey.state & LockMask))) {
 	index += 1;
     }
-    sym = XkbKeycodeToKeysym(dispPtr->display, eventPtr->xkey.keycode, 0,
-	    index);
+    sym = LookupKeysym(dispPtr, eventPtr->xkey.keycode, index);
 
     /*
      * Special handling: if the key was shifted because of Lock, but lock is
@@ -378,8 +386,7 @@ TkpGetKeySym(
 		|| ((sym >= XK_Agrave) && (sym <= XK_Odiaeresis))
 		|| ((sym >= XK_Oslash) && (sym <= XK_Thorn)))) {
 	    index &= ~1;
-	    sym = XkbKeycodeToKeysym(dispPtr->display, eventPtr->xkey.keycode,
-		    0, index);
+	    sym = LookupKeysym(dispPtr, eventPtr->xkey.keycode, index);
 	}
     }
 
@@ -389,8 +396,7 @@ TkpGetKeySym(
      */
 
     if ((index & 1) && (sym == NoSymbol)) {
-	sym = XkbKeycodeToKeysym(dispPtr->display, eventPtr->xkey.keycode,
-		0, index & ~1);
+	sym = LookupKeysym(dispPtr, eventPtr->xkey.keycode, index & ~1);
     }
     return sym;
 }
@@ -421,10 +427,30 @@ TkpInitKeymapInfo(
     XModifierKeymap *modMapPtr;
     KeyCode *codePtr;
     KeySym keysym;
-    int count, i, j, max, arraySize;
+    int count, i, j, max, arraySize, minKeycode, maxKeycode;
 #define KEYCODE_ARRAY_SIZE 20
 
     dispPtr->bindInfoStale = 0;
+
+    /*
+     * Translate the whole keyboard mapping once, so that key events can be
+     * turned into keysyms with a table lookup instead of going through Xkb
+     * each time. The table is rebuilt whenever a MappingNotify event marks
+     * the binding information as stale.
+     */
+
+    if (dispPtr->keysymTable == NULL) {
+	dispPtr->keysymTable = (KeySym *)ckalloc(KEYSYM_TABLE_SIZE);
+    }
+    memset(dispPtr->keysymTable, 0, KEYSYM_TABLE_SIZE);
+    XDisplayKeycodes(dispPtr->display, &minKeycode, &maxKeycode);
+    for (i = minKeycode; i <= maxKeycode && i <= 0xff; i++) {
+	for (j = 0; j < 4; j++) {
+	    dispPtr->keysymTable[i*4 + j] =
+		    XkbKeycodeToKeysym(dispPtr->display, i, 0, j);
+	}
+    }
+
     modMapPtr = XGetModifierMapping(dispPtr->display);
 
     /*
@@ -439,7 +465,7 @@ TkpInitKeymapInfo(
 	if (*codePtr == 0) {
 	    continue;
 	}
-	keysym = XkbKeycodeToKeysym(dispPtr->display, *codePtr, 0, 0);
+	keysym = LookupKeysym(dispPtr, *codePtr, 0);
 	if (keysym == XK_Shift_Lock) {
 	    dispPtr->lockUsage = LU_SHIFT;
 	    break;
@@ -465,7 +491,7 @@ TkpInitKeymapInfo(
 	if (*codePtr == 0) {
 	    continue;
 	}
-	keysym = XkbKeycodeToKeysym(dispPtr->display, *codePtr, 0, 0);
+	keysym = LookupKeysym(dispPtr, *codePtr, 0);
 
 	if (keysym == XK_Mode_switch) {
 	    dispPtr->modeModMask |= ShiftMask << (i/modMapPtr->max_keypermod);
@@ -1753,10 +1753,22 @@ TkpComputeStandardMenuGeometry(
 	     * (if any), and the width of the accelerator to be displayed to
 	     * the right of the label (if any). These sizes depend, of course,
 	     * on the type of the entry.
+	     *
+	     * Measuring labels and accelerators is the expensive part, so the
+	     * results are kept in the entry until it is reconfigured. That way
+	     * changing one entry of a long menu only measures that entry.
 	     */
 
-	    GetMenuLabelGeometry(mePtr, tkfont, fmPtr, &width, &height);
-	    mePtr->height = height;
+	    if (!(mePtr->entryFlags & ENTRY_GEOMETRY_CACHED)) {
+		GetMenuLabelGeometry(mePtr, tkfont, fmPtr,
+			&mePtr->labelGeomWidth, &mePtr->labelGeomHeight);
+		GetMenuAccelGeometry(menuPtr, mePtr, tkfont, fmPtr,
+			&mePtr->accelGeomWidth, &mePtr->accelGeomHeight);
+		mePtr->entryFlags |= ENTRY_GEOMETRY_CACHED;
+	    }
+
+	    width = mePtr->labelGeomWidth;
+	    mePtr->height = mePtr->labelGeomHeight;
 	    if (!mePtr->hideMargin) {
 		width += MENU_MARGIN_WIDTH;
 	    }
@@ -1764,8 +1776,8 @@ TkpComputeStandardMenuGeometry(
 	    	labelWidth = width;
 	    }
 
-	    GetMenuAccelGeometry(menuPtr, mePtr, tkfont,
-		    fmPtr, &width, &height);
+	    width = mePtr->accelGeomWidth;
+	    height = mePtr->accelGeomHeight;
 	    if (height > mePtr->height) {
 	    	mePtr->height = height;
 	    }
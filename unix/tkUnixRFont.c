@@ -45,15 +45,39 @@ typedef struct {
     UnixFtColorList colors[MAX_CACHED_COLORS];
 } UnixFtFont;
 
+/*
+ * Maximum number of font sets remembered by GetFontSet. When the cache is
+ * full, it is emptied before adding the next one.
+ */
+
+#define MAX_CACHED_FONTSETS 64
+
 /*
  * Used to describe the current clipping box. Can't be passed normally because
  * the information isn't retrievable from the GC.
+ *
+ * Also holds the results of the expensive fontconfig queries. The named
+ * fonts of an application mostly share a handful of distinct patterns, and
+ * the font families change only when fontconfig reloads its configuration.
  */
 
 typedef struct {
     Region clipRegion;		/* The clipping region, or None. */
+    int cacheInitialized;	/* Non-zero if the tables below are set up. */
+    FcConfig *cacheConfig;	/* The fontconfig configuration the cached
+				 * results were obtained from. */
+    Tcl_HashTable fontSetTable;	/* Maps the unparsed name of a substituted
+				 * pattern to the FcFontSet returned by
+				 * FcFontSort for it. */
+    Tcl_HashTable familyTable;	/* Maps a Display pointer to a Tcl list of
+				 * the font families available on it. */
 } ThreadSpecificData;
 static Tcl_ThreadDataKey dataKey;
+
+static ThreadSpecificData *GetFontCache(void);
+static void		FlushFontCache(ThreadSpecificData *tsdPtr);
+static void		FontCacheExitProc(ClientData clientData);
+static FcFontSet *	GetFontSet(FcPattern *pattern);
 
 /*
  *-------------------------------------------------------------------------
@@ -89,6 +113,203 @@ TkpFontPkgInit(
 {
     (void)mainPtr;
 }
+
+/*
+ *-------------------------------------------------------------------------
+ *
+ * GetFontCache --
+ *
+ *	Returns the thread's cache of fontconfig query results, after making
+ *	sure that it is set up and that it belongs to the current fontconfig
+ *	configuration.
+ *
+ * Results:
+ *	The ThreadSpecificData holding the cache.
+ *
+ * Side effects:
+ *	The cache is created on first use, and emptied if fontconfig has
+ *	switched to a new configuration (e.g. because fonts were installed).
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static ThreadSpecificData *
+GetFontCache(void)
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+    FcConfig *config = FcConfigGetCurrent();
+
+    if (!tsdPtr->cacheInitialized) {
+	Tcl_InitHashTable(&tsdPtr->fontSetTable, TCL_STRING_KEYS);
+	Tcl_InitHashTable(&tsdPtr->familyTable, TCL_ONE_WORD_KEYS);
+	tsdPtr->cacheConfig = config;
+	tsdPtr->cacheInitialized = 1;
+	Tcl_CreateThreadExitHandler(FontCacheExitProc, NULL);
+    } else if (tsdPtr->cacheConfig != config) {
+	FlushFontCache(tsdPtr);
+	tsdPtr->cacheConfig = config;
+    }
+    return tsdPtr;
+}
+
+/*
+ *-------------------------------------------------------------------------
+ *
+ * FlushFontCache --
+ *
+ *	Forgets all cached fontconfig query results.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The cached font sets and family lists are released.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static void
+FlushFontCache(
+    ThreadSpecificData *tsdPtr)
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch search;
+
+    for (hPtr = Tcl_FirstHashEntry(&tsdPtr->fontSetTable, &search);
+	    hPtr != NULL; hPtr = Tcl_NextHashEntry(&search)) {
+	FcFontSetDestroy((FcFontSet *) Tcl_GetHashValue(hPtr));
+    }
+    Tcl_DeleteHashTable(&tsdPtr->fontSetTable);
+    Tcl_InitHashTable(&tsdPtr->fontSetTable, TCL_STRING_KEYS);
+
+    for (hPtr = Tcl_FirstHashEntry(&tsdPtr->familyTable, &search);
+	    hPtr != NULL; hPtr = Tcl_NextHashEntry(&search)) {
+	Tcl_DecrRefCount((Tcl_Obj *) Tcl_GetHashValue(hPtr));
+    }
+    Tcl_DeleteHashTable(&tsdPtr->familyTable);
+    Tcl_InitHashTable(&tsdPtr->familyTable, TCL_ONE_WORD_KEYS);
+}
+
+static void
+FontCacheExitProc(
+    TCL_UNUSED(void *))
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+
+    if (tsdPtr->cacheInitialized) {
+	FlushFontCache(tsdPtr);
+	Tcl_DeleteHashTable(&tsdPtr->fontSetTable);
+	Tcl_DeleteHashTable(&tsdPtr->familyTable);
+	tsdPtr->cacheInitialized = 0;
+    }
+}
+
+/*
+ *-------------------------------------------------------------------------
+ *
+ * TkUnixFontCleanup --
+ *
+ *	This function is called when a display is closed, to release any
+ *	font information remembered for it.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The display's cached list of font families is released, so that a
+ *	display opened later at the same address does not inherit it.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+void
+TkUnixFontCleanup(
+    TkDisplay *dispPtr)		/* The display being closed. */
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+    Tcl_HashEntry *hPtr;
+
+    if (!tsdPtr->cacheInitialized) {
+	return;
+    }
+    hPtr = Tcl_FindHashEntry(&tsdPtr->familyTable, (char *) dispPtr->display);
+    if (hPtr != NULL) {
+	Tcl_DecrRefCount((Tcl_Obj *) Tcl_GetHashValue(hPtr));
+	Tcl_DeleteHashEntry(hPtr);
+    }
+}
+
+/*
+ *-------------------------------------------------------------------------
+ *
+ * GetFontSet --
+ *
+ *	Returns the fonts matching a (substituted) pattern, best match first,
+ *	like FcFontSort does. Sorting all installed fonts against the pattern
+ *	is expensive, so the result is remembered for the next font with the
+ *	same pattern.
+ *
+ * Results:
+ *	A font set owned by the caller, to be freed with FcFontSetDestroy, or
+ *	NULL if no font matches.
+ *
+ * Side effects:
+ *	The result may be added to the thread's font cache.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+static FcFontSet *
+GetFontSet(
+    FcPattern *pattern)		/* Pattern after configuration and default
+				 * substitutions. */
+{
+    ThreadSpecificData *tsdPtr = GetFontCache();
+    FcFontSet *set, *copy;
+    FcResult result;
+    FcChar8 *name;
+    Tcl_HashEntry *hPtr;
+    int i, isNew;
+
+    name = FcNameUnparse(pattern);
+    if (name == NULL) {
+	return FcFontSort(0, pattern, FcTrue, NULL, &result);
+    }
+    hPtr = Tcl_FindHashEntry(&tsdPtr->fontSetTable, (char *) name);
+    if (hPtr == NULL) {
+	set = FcFontSort(0, pattern, FcTrue, NULL, &result);
+	if (!set || set->nfont == 0) {
+	    FcStrFree(name);
+	    return set;
+	}
+	if (tsdPtr->fontSetTable.numEntries >= MAX_CACHED_FONTSETS) {
+	    FlushFontCache(tsdPtr);
+	}
+	hPtr = Tcl_CreateHashEntry(&tsdPtr->fontSetTable, (char *) name,
+		&isNew);
+	Tcl_SetHashValue(hPtr, set);
+    } else {
+	set = (FcFontSet *) Tcl_GetHashValue(hPtr);
+    }
+    FcStrFree(name);
+
+    /*
+     * Hand out a copy that shares the font patterns, since every font
+     * destroys its own set when it is freed.
+     */
+
+    copy = FcFontSetCreate();
+    for (i = 0; i < set->nfont; i++) {
+	FcPatternReference(set->fonts[i]);
+	if (!FcFontSetAdd(copy, set->fonts[i])) {
+	    FcPatternDestroy(set->fonts[i]);
+	}
+    }
+    return copy;
+}
 
 static XftFont *
 GetFont(
@@ -285,7 +506,6 @@ InitFont(
 {
     FcFontSet *set;
     FcCharSet *charset;
-    FcResult result;
     XftFont *ftFont;
     int i, iWidth, errorFlag;
     Tk_ErrorHandler handler;
@@ -301,8 +521,11 @@ InitFont(
      * Generate the list of fonts
      */
 
-    set = FcFontSort(0, pattern, FcTrue, NULL, &result);
+    set = GetFontSet(pattern);
     if (!set || set->nfont == 0) {
+	if (set) {
+	    FcFontSetDestroy(set);
+	}
 	ckfree(fontPtr);
 	return NULL;
     }
@@ -579,6 +802,10 @@ TkpDeleteFont(
  *	Modifies interp's result object to hold a list of all the available
  *	font families.
  *
+ * Side effects:
+ *	The list is remembered for the display, until fontconfig reloads its
+ *	configuration or the display is closed.
+ *
  *---------------------------------------------------------------------------
  */
 
@@ -587,9 +814,25 @@ TkpGetFontFamilies(
     Tcl_Interp *interp,		/* Interp to hold result. */
     Tk_Window tkwin)		/* For display to query. */
 {
+    ThreadSpecificData *tsdPtr;
+    Tcl_HashEntry *hPtr;
     Tcl_Obj *resultPtr;
     XftFontSet *list;
-    int i;
+    int i, isNew;
+
+    /*
+     * Let fontconfig notice new fonts (subject to its rescan interval) the
+     * same way an uncached XftListFonts would.
+     */
+
+    FcInitBringUptoDate();
+    tsdPtr = GetFontCache();
+    hPtr = Tcl_CreateHashEntry(&tsdPtr->familyTable,
+	    (char *) Tk_Display(tkwin), &isNew);
+    if (!isNew) {
+	Tcl_SetObjResult(interp, (Tcl_Obj *) Tcl_GetHashValue(hPtr));
+	return;
+    }
 
     resultPtr = Tcl_NewListObj(0, NULL);
 
@@ -608,6 +851,8 @@ TkpGetFontFamilies(
     }
     XftFontSetDestroy(list);
 
+    Tcl_IncrRefCount(resultPtr);
+    Tcl_SetHashValue(hPtr, resultPtr);
     Tcl_SetObjResult(interp, resultPtr);
 }
 
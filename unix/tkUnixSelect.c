@@ -1504,6 +1504,9 @@ SelCvtFromX32(
      * MIME types). [Bug 1353414]
      */
 
+    if (type == XA_ATOM && numValues > 1) {
+	TkCacheAtomNames(tkwin, (Atom *) propPtr, numValues);
+    }
     for ( ; numValues > 0; propPtr++, numValues--) {
 	if (type == XA_ATOM) {
 	    Tcl_DStringAppendElement(dsPtr,
@@ -215,6 +215,21 @@ typedef struct TkWmInfo {
     int iconDataSize;		/* size of iconphoto image data */
     unsigned char *iconDataPtr;	/* iconphoto image data, if set */
     struct TkWmInfo *nextPtr;	/* Next in list of all top-level windows. */
+
+    /*
+     * Information used when the display does not wait for the window manager
+     * synchronously (see [tk wmsync]).
+     */
+
+    unsigned long asyncSerial;	/* Serial number of the request that an
+				 * outstanding asynchronous configure wait is
+				 * for. */
+    int asyncMapped;		/* Mapped state that an outstanding
+				 * asynchronous map wait is for. */
+    Tcl_WideInt asyncStart;	/* Time at which the outstanding asynchronous
+				 * waits started, in microseconds. */
+    Tcl_TimerToken asyncTimer;	/* Gives up on the outstanding asynchronous
+				 * waits, NULL if there are none. */
 } WmInfo;
 
 /*
@@ -260,6 +275,12 @@ typedef struct TkWmInfo {
  * WM_WITHDRAWN -		non-zero means that this window has explicitly
  *				been withdrawn. If it's a transient, it should
  *				not mirror state changes in the container.
+ * WM_ASYNC_CONFIGURE -		non-zero means a geometry request has been
+ *				made without waiting for the window manager to
+ *				respond; WM_SYNC_PENDING stays set until the
+ *				ConfigureNotify for asyncSerial arrives.
+ * WM_ASYNC_MAP -		likewise for a map or unmap request; ends when
+ *				the window reaches the asyncMapped state.
  */
 
 #define WM_NEVER_MAPPED			1
@@ -276,6 +297,15 @@ typedef struct TkWmInfo {
 #define WM_WIDTH_NOT_RESIZABLE		0x1000
 #define WM_HEIGHT_NOT_RESIZABLE		0x2000
 #define WM_WITHDRAWN			0x4000
+#define WM_ASYNC_CONFIGURE		0x8000
+#define WM_ASYNC_MAP			0x10000
+
+/*
+ * How long to wait for the window manager to respond to a request before
+ * giving up, in milliseconds.
+ */
+
+#define WM_SYNC_TIMEOUT			2000
 
 /*
  * Wrapper for XGetWindowProperty and XChangeProperty to make them a *bit*
@@ -334,11 +364,46 @@ typedef struct WaitRestrictInfo {
 				 * type has been found. */
 } WaitRestrictInfo;
 
+/*
+ * Photos used with "wm iconphoto" are converted to _NET_WM_ICON ARGB pixels
+ * once and the result is kept, keyed by photo handle, until the photo's
+ * change stamp moves on. Applications commonly set the same icon photos on
+ * every toplevel, so this avoids repeating the per-pixel conversion. Entries
+ * for deleted photos can't be detected, so the table is simply flushed when
+ * the converted pixels it holds would take more than ICON_CACHE_MAX_BYTES.
+ */
+
+typedef struct IconPhotoCache {
+    size_t bytes;		/* Size of this structure. */
+    unsigned long stamp;	/* Change stamp of the photo when converted. */
+    int width, height;		/* Size of the photo when converted. */
+    unsigned long pixels[1];	/* width*height ARGB cardinals; actually as
+				 * large as necessary. */
+} IconPhotoCache;
+
+#define ICON_CACHE_MAX_BYTES	(256 * 1024)
+
+typedef struct {
+    int initialized;		/* Set once iconCache has been set up. */
+    Tcl_HashTable iconCache;	/* Maps Tk_PhotoHandle to IconPhotoCache. */
+    size_t iconCacheBytes;	/* Memory taken by the entries of
+				 * iconCache. */
+} ThreadSpecificData;
+static Tcl_ThreadDataKey dataKey;
+
 /*
  * Forward declarations for functions defined in this file:
  */
 
+static void		AsyncWaitTimeoutProc(ClientData clientData);
+static void		FlushIconCache(ThreadSpecificData *tsdPtr);
+static void		TrimIconCache(void);
+static const unsigned long *GetIconPhotoPixels(Tk_PhotoHandle photo,
+			    int width, int height);
+static void		IconCacheThreadExitProc(ClientData clientData);
+static void		BeginAsyncWait(WmInfo *wmPtr, int flag);
 static int		ComputeReparentGeometry(WmInfo *wmPtr);
+static void		EndAsyncWait(WmInfo *wmPtr, int flags, int timedOut);
 static void		ConfigureEvent(WmInfo *wmPtr,
 			    XConfigureEvent *eventPtr);
 static void		CreateWrapper(WmInfo *wmPtr);
@@ -368,6 +433,8 @@ static Tcl_Obj *	GetNetWmType(TkWindow *winPtr);
 static void 		SetNetWmState(TkWindow*, const char *atomName, int on);
 static void 		CheckNetWmState(WmInfo *, Atom *atoms, int numAtoms);
 static void 		UpdateNetWmState(WmInfo *);
+static void		RecordWmWait(TkDisplay *dispPtr, Tcl_WideInt start,
+			    int timedOut);
 static void		WaitForConfigureNotify(TkWindow *winPtr,
 			    unsigned long serial);
 static int		WaitForEvent(Display *display,
@@ -535,6 +602,7 @@ void TkWmCleanup(
 	if (wmPtr->clientMachine != NULL) {
 	    ckfree(wmPtr->clientMachine);
 	}
+	Tcl_DeleteTimerHandler(wmPtr->asyncTimer);
 	ckfree(wmPtr);
     }
     if (dispPtr->iconDataPtr != NULL) {
@@ -947,6 +1015,7 @@ TkWmDeadWindow(
 		StructureNotifyMask, WmWaitMapProc, winPtr);
 	wmPtr->containerPtr = NULL;
     }
+    Tcl_DeleteTimerHandler(wmPtr->asyncTimer);
     ckfree(wmPtr);
     winPtr->wmInfoPtr = NULL;
 }
@@ -1821,6 +1890,7 @@ WmForgetCmd(
 	TkWmDeadWindow(winPtr);
 	winPtr->flags &=
 		~(TK_TOP_HIERARCHY|TK_TOP_LEVEL|TK_HAS_WRAPPER|TK_WIN_MANAGED);
+	TkGrabTreeChanged(winPtr->dispPtr);
 	RemapWindows(winPtr, winPtr->parentPtr);
 
         /*
@@ -2383,9 +2453,11 @@ WmIconphotoCmd(
 {
     WmInfo *wmPtr = winPtr->wmInfoPtr;
     Tk_PhotoHandle photo;
-    Tk_PhotoImageBlock block;
-    int i, size = 0, width, height, index = 0, x, y, isDefault = 0;
+    int i, size = 0, width, height, index = 0, isDefault = 0, sameIcon;
+    int oldSize;
     unsigned long *iconPropertyData;
+    const unsigned long *pixels;
+    unsigned char *oldData;
 
     if (objc < 4) {
 	Tcl_WrongNumArgs(interp, 2, objv,
@@ -2436,7 +2508,6 @@ WmIconphotoCmd(
     if (iconPropertyData == NULL) {
 	return TCL_ERROR;
     }
-    memset(iconPropertyData, 0, sizeof(unsigned long) * size);
 
     for (i = 3 + isDefault; i < objc; i++) {
 	photo = Tk_FindPhoto(interp, Tcl_GetString(objv[i]));
@@ -2449,7 +2520,11 @@ WmIconphotoCmd(
 	    return TCL_ERROR;
 	}
 	Tk_PhotoGetSize(photo, &width, &height);
-	Tk_PhotoGetImage(photo, &block);
+	pixels = GetIconPhotoPixels(photo, width, height);
+	if (pixels == NULL) {
+	    ckfree((char *) iconPropertyData);
+	    return TCL_ERROR;
+	}
 
 	/*
 	 * Each image data will be placed as an array of 32bit packed
@@ -2467,25 +2542,35 @@ WmIconphotoCmd(
 	 * Data is in rows, left to right and top to bottom. The data will be
 	 * endian-swapped going to the server if necessary. [Bug 2830420]
 	 *
-	 * The image data will be encoded in the iconPropertyData array.
+	 * The image data will be encoded in the iconPropertyData array; the
+	 * pixels come from the conversion cache.
 	 */
 
 	iconPropertyData[index++] = (unsigned long) width;
 	iconPropertyData[index++] = (unsigned long) height;
-	for (y = 0; y < height; y++) {
-	    for (x = 0; x < width; x++) {
-		unsigned char *pixelPtr =
-			block.pixelPtr + x*block.pixelSize + y*block.pitch;
-		unsigned long R, G, B, A;
-
-		R = pixelPtr[block.offset[0]];
-		G = pixelPtr[block.offset[1]];
-		B = pixelPtr[block.offset[2]];
-		A = pixelPtr[block.offset[3]];
-		iconPropertyData[index++] = A<<24 | R<<16 | G<<8 | B<<0;
-	    }
+	if (width * height > 0) {
+	    memcpy(iconPropertyData + index, pixels,
+		    sizeof(unsigned long) * width * height);
+	    index += width * height;
 	}
     }
+    TrimIconCache();
+
+    /*
+     * Re-sending _NET_WM_ICON transfers the whole array to the server (and
+     * makes the window manager rescale it), so skip that when the icon the
+     * window would end up with is the one it already has.
+     */
+
+    oldData = wmPtr->iconDataPtr;
+    oldSize = wmPtr->iconDataSize;
+    if (oldData == NULL) {
+	oldData = winPtr->dispPtr->iconDataPtr;
+	oldSize = winPtr->dispPtr->iconDataSize;
+    }
+    sameIcon = (oldData != NULL) && (oldSize == size) && (memcmp(oldData,
+	    iconPropertyData, sizeof(unsigned long) * size) == 0);
+
     if (wmPtr->iconDataPtr != NULL) {
 	ckfree(wmPtr->iconDataPtr);
 	wmPtr->iconDataPtr = NULL;
@@ -2500,11 +2585,158 @@ WmIconphotoCmd(
 	wmPtr->iconDataPtr = (unsigned char *) iconPropertyData;
 	wmPtr->iconDataSize = size;
     }
-    if (!(wmPtr->flags & WM_NEVER_MAPPED)) {
+    if (!sameIcon && !(wmPtr->flags & WM_NEVER_MAPPED)) {
 	UpdatePhotoIcon(winPtr);
     }
     return TCL_OK;
 }
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * GetIconPhotoPixels --
+ *
+ *	Return the pixels of a photo converted to _NET_WM_ICON format (32bit
+ *	packed ARGB cardinals, rows left to right and top to bottom). The
+ *	conversion is cached per photo and redone only when the photo has
+ *	changed since.
+ *
+ * Results:
+ *	Pointer to width*height cardinals, owned by the cache and valid until
+ *	the next call. NULL if memory could not be allocated.
+ *
+ * Side effects:
+ *	May add, replace or flush entries in the per-thread icon cache.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static const unsigned long *
+GetIconPhotoPixels(
+    Tk_PhotoHandle photo,	/* Photo to convert. */
+    int width, int height)	/* Current size of the photo. */
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+    unsigned long stamp = TkPhotoGetChangeStamp(photo);
+    Tk_PhotoImageBlock block;
+    Tcl_HashEntry *hPtr;
+    IconPhotoCache *cachePtr;
+    unsigned long *dstPtr;
+    size_t bytes;
+    int x, y, isNew;
+
+    if (!tsdPtr->initialized) {
+	tsdPtr->initialized = 1;
+	Tcl_InitHashTable(&tsdPtr->iconCache, TCL_ONE_WORD_KEYS);
+	Tcl_CreateThreadExitHandler(IconCacheThreadExitProc, NULL);
+    }
+
+    hPtr = Tcl_FindHashEntry(&tsdPtr->iconCache, (char *) photo);
+    if (hPtr != NULL) {
+	cachePtr = (IconPhotoCache *)Tcl_GetHashValue(hPtr);
+	if ((cachePtr->stamp == stamp) && (cachePtr->width == width)
+		&& (cachePtr->height == height)) {
+	    return cachePtr->pixels;
+	}
+	tsdPtr->iconCacheBytes -= cachePtr->bytes;
+	ckfree(cachePtr);
+	Tcl_DeleteHashEntry(hPtr);
+    }
+
+    bytes = offsetof(IconPhotoCache, pixels)
+	    + sizeof(unsigned long) * (width * height + 1);
+    if (tsdPtr->iconCacheBytes + bytes > ICON_CACHE_MAX_BYTES) {
+	FlushIconCache(tsdPtr);
+    }
+    cachePtr = (IconPhotoCache *)attemptckalloc(bytes);
+    if (cachePtr == NULL) {
+	return NULL;
+    }
+    cachePtr->bytes = bytes;
+    cachePtr->stamp = stamp;
+    cachePtr->width = width;
+    cachePtr->height = height;
+
+    Tk_PhotoGetImage(photo, &block);
+    dstPtr = cachePtr->pixels;
+    for (y = 0; y < height; y++) {
+	for (x = 0; x < width; x++) {
+	    unsigned char *pixelPtr =
+		    block.pixelPtr + x*block.pixelSize + y*block.pitch;
+	    unsigned long R, G, B, A;
+
+	    R = pixelPtr[block.offset[0]];
+	    G = pixelPtr[block.offset[1]];
+	    B = pixelPtr[block.offset[2]];
+	    A = pixelPtr[block.offset[3]];
+	    *dstPtr++ = A<<24 | R<<16 | G<<8 | B<<0;
+	}
+    }
+
+    hPtr = Tcl_CreateHashEntry(&tsdPtr->iconCache, (char *) photo, &isNew);
+    Tcl_SetHashValue(hPtr, cachePtr);
+    tsdPtr->iconCacheBytes += bytes;
+    return cachePtr->pixels;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * FlushIconCache, TrimIconCache, IconCacheThreadExitProc --
+ *
+ *	Release all converted icon photos held by the current thread, release
+ *	them once a single photo too large for the cache has been used, and
+ *	clean up the cache when the thread exits.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Memory is freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+FlushIconCache(
+    ThreadSpecificData *tsdPtr)
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch search;
+
+    for (hPtr = Tcl_FirstHashEntry(&tsdPtr->iconCache, &search);
+	    hPtr != NULL; hPtr = Tcl_NextHashEntry(&search)) {
+	ckfree(Tcl_GetHashValue(hPtr));
+	Tcl_DeleteHashEntry(hPtr);
+    }
+    tsdPtr->iconCacheBytes = 0;
+}
+
+static void
+TrimIconCache(void)
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+
+    if (tsdPtr->iconCacheBytes > ICON_CACHE_MAX_BYTES) {
+	FlushIconCache(tsdPtr);
+    }
+}
+
+static void
+IconCacheThreadExitProc(
+    TCL_UNUSED(ClientData))
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+
+    if (tsdPtr->initialized) {
+	FlushIconCache(tsdPtr);
+	Tcl_DeleteHashTable(&tsdPtr->iconCache);
+	tsdPtr->initialized = 0;
+    }
+}
 
 /*
  *----------------------------------------------------------------------
@@ -2723,6 +2955,7 @@ WmManageCmd(
 	Tk_UnmapWindow(frameWin);
 	winPtr->flags |=
 		TK_TOP_HIERARCHY|TK_TOP_LEVEL|TK_HAS_WRAPPER|TK_WIN_MANAGED;
+	TkGrabTreeChanged(winPtr->dispPtr);
 	if (wmPtr == NULL) {
 	    TkWmNewWindow(winPtr);
 	    TkWmMapWindow(winPtr);
@@ -4450,15 +4683,25 @@ WrapperEventProc(
 	if (!(wmPtr->flags & WM_NEVER_MAPPED)) {
 	    ConfigureEvent(wmPtr, &eventPtr->xconfigure);
 	}
+	if ((wmPtr->flags & WM_ASYNC_CONFIGURE) && ((long)
+		(eventPtr->xconfigure.serial - wmPtr->asyncSerial) >= 0)) {
+	    EndAsyncWait(wmPtr, WM_ASYNC_CONFIGURE, 0);
+	}
     } else if (eventPtr->type == MapNotify) {
 	wmPtr->wrapperPtr->flags |= TK_MAPPED;
 	wmPtr->winPtr->flags |= TK_MAPPED;
 	XMapWindow(wmPtr->winPtr->display, wmPtr->winPtr->window);
+	if ((wmPtr->flags & WM_ASYNC_MAP) && wmPtr->asyncMapped) {
+	    EndAsyncWait(wmPtr, WM_ASYNC_MAP, 0);
+	}
 	goto doMapEvent;
     } else if (eventPtr->type == UnmapNotify) {
 	wmPtr->wrapperPtr->flags &= ~TK_MAPPED;
 	wmPtr->winPtr->flags &= ~TK_MAPPED;
 	XUnmapWindow(wmPtr->winPtr->display, wmPtr->winPtr->window);
+	if ((wmPtr->flags & WM_ASYNC_MAP) && !wmPtr->asyncMapped) {
+	    EndAsyncWait(wmPtr, WM_ASYNC_MAP, 0);
+	}
 	goto doMapEvent;
     } else if (eventPtr->type == ReparentNotify) {
 	ReparentEvent(wmPtr, &eventPtr->xreparent);
@@ -5177,8 +5420,20 @@ WaitForConfigureNotify(
 {
     WmInfo *wmPtr = winPtr->wmInfoPtr;
     XEvent event;
-    int diff, code;
+    int diff, code = TCL_OK;
     int gotConfig = 0;
+    Tcl_WideInt start;
+
+    /*
+     * In asynchronous mode, don't wait at all: treat configure events as
+     * responses to our request until the one for it arrives.
+     */
+
+    if (winPtr->dispPtr->flags & TK_DISPLAY_WM_ASYNC) {
+	wmPtr->asyncSerial = serial;
+	BeginAsyncWait(wmPtr, WM_ASYNC_CONFIGURE);
+	return;
+    }
 
     /*
      * One more tricky detail about this function. In some cases the window
@@ -5187,6 +5442,7 @@ WaitForConfigureNotify(
      * this situation, only wait for a few seconds, then give up.
      */
 
+    start = TkGetMicroseconds();
     while (!gotConfig) {
 	wmPtr->flags |= WM_SYNC_PENDING;
 	code = WaitForEvent(winPtr->display, wmPtr, ConfigureNotify, &event);
@@ -5203,6 +5459,7 @@ WaitForConfigureNotify(
 	    gotConfig = 1;
 	}
     }
+    RecordWmWait(winPtr->dispPtr, start, code != TCL_OK);
     wmPtr->flags &= ~WM_MOVE_PENDING;
     if (winPtr->dispPtr->flags & TK_DISPLAY_WM_TRACING) {
 	printf("WaitForConfigureNotify finished with %s, serial %ld\n",
@@ -5260,7 +5517,7 @@ WaitForEvent(
     prevProc = Tk_RestrictEvents(WaitRestrictProc, &info, &prevArg);
 
     Tcl_GetTime(&timeout);
-    timeout.sec += 2;
+    timeout.sec += WM_SYNC_TIMEOUT / 1000;
 
     while (!info.foundEvent) {
 	if (!TkUnixDoOneXEvent(&timeout)) {
@@ -5357,8 +5614,18 @@ WaitForMapNotify(
 {
     WmInfo *wmPtr = winPtr->wmInfoPtr;
     XEvent event;
-    int code;
+    int code = TCL_OK, waited = 0;
+    Tcl_WideInt start;
+
+    if (winPtr->dispPtr->flags & TK_DISPLAY_WM_ASYNC) {
+	if ((mapped != 0) != ((winPtr->flags & TK_MAPPED) != 0)) {
+	    wmPtr->asyncMapped = mapped;
+	    BeginAsyncWait(wmPtr, WM_ASYNC_MAP);
+	}
+	return;
+    }
 
+    start = TkGetMicroseconds();
     while (1) {
 	if (mapped) {
 	    if (winPtr->flags & TK_MAPPED) {
@@ -5368,6 +5635,7 @@ WaitForMapNotify(
 	    break;
 	}
 	wmPtr->flags |= WM_SYNC_PENDING;
+	waited = 1;
 	code = WaitForEvent(winPtr->display, wmPtr,
 		mapped ? MapNotify : UnmapNotify, &event);
 	wmPtr->flags &= ~WM_SYNC_PENDING;
@@ -5384,12 +5652,117 @@ WaitForMapNotify(
 	    break;
 	}
     }
+    if (waited) {
+	RecordWmWait(winPtr->dispPtr, start, code != TCL_OK);
+    }
     wmPtr->flags &= ~WM_MOVE_PENDING;
     if (winPtr->dispPtr->flags & TK_DISPLAY_WM_TRACING) {
 	printf("WaitForMapNotify finished with %s (winPtr %p, wmPtr %p)\n",
 		winPtr->pathName, winPtr, wmPtr);
     }
 }
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * BeginAsyncWait, EndAsyncWait, AsyncWaitTimeoutProc --
+ *
+ *	These functions replace WaitForConfigureNotify and WaitForMapNotify
+ *	when the display is in asynchronous mode. Instead of blocking until
+ *	the window manager responds, BeginAsyncWait keeps WM_SYNC_PENDING set
+ *	so that the events which eventually arrive are still recognized as
+ *	responses to our own requests. WrapperEventProc calls EndAsyncWait
+ *	when the awaited event shows up; if it never does, the timer gives up
+ *	after the same delay as the synchronous wait would.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Flags in wmPtr change, a timer handler may be created or deleted and
+ *	the wait statistics of the display are updated.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+BeginAsyncWait(
+    WmInfo *wmPtr,		/* Top-level window making the request. */
+    int flag)			/* WM_ASYNC_CONFIGURE or WM_ASYNC_MAP. */
+{
+    if (!(wmPtr->flags & (WM_ASYNC_CONFIGURE|WM_ASYNC_MAP))) {
+	wmPtr->asyncStart = TkGetMicroseconds();
+	wmPtr->asyncTimer = Tcl_CreateTimerHandler(WM_SYNC_TIMEOUT,
+		AsyncWaitTimeoutProc, wmPtr);
+    }
+    wmPtr->flags |= flag | WM_SYNC_PENDING;
+}
+
+static void
+EndAsyncWait(
+    WmInfo *wmPtr,		/* Top-level window the response is for. */
+    int flags,			/* Which waits are over. */
+    int timedOut)		/* Non-zero means the window manager never
+				 * responded. */
+{
+    wmPtr->flags &= ~flags;
+    if (wmPtr->flags & (WM_ASYNC_CONFIGURE|WM_ASYNC_MAP)) {
+	return;
+    }
+    wmPtr->flags &= ~(WM_SYNC_PENDING|WM_MOVE_PENDING);
+    Tcl_DeleteTimerHandler(wmPtr->asyncTimer);
+    wmPtr->asyncTimer = NULL;
+    RecordWmWait(wmPtr->winPtr->dispPtr, wmPtr->asyncStart, timedOut);
+    if (wmPtr->winPtr->dispPtr->flags & TK_DISPLAY_WM_TRACING) {
+	printf("EndAsyncWait %s with %s\n",
+		timedOut ? "giving up" : "finished", wmPtr->winPtr->pathName);
+    }
+}
+
+static void
+AsyncWaitTimeoutProc(
+    ClientData clientData)	/* Top-level window that got no response. */
+{
+    WmInfo *wmPtr = (WmInfo *)clientData;
+
+    wmPtr->asyncTimer = NULL;
+    EndAsyncWait(wmPtr, WM_ASYNC_CONFIGURE|WM_ASYNC_MAP, 1);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * RecordWmWait --
+ *
+ *	Adds a completed wait for the window manager to the statistics
+ *	reported by [tk wmwaitprofile].
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The wait statistics of the display are updated.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+RecordWmWait(
+    TkDisplay *dispPtr,		/* Display the wait happened on. */
+    Tcl_WideInt start,		/* When the wait started, in microseconds. */
+    int timedOut)		/* Non-zero means the wait gave up. */
+{
+    Tcl_WideInt elapsed = TkGetMicroseconds() - start;
+
+    dispPtr->wmWaitCount++;
+    if (timedOut) {
+	dispPtr->wmWaitTimeouts++;
+    }
+    dispPtr->wmWaitTime += elapsed;
+    if (elapsed > dispPtr->wmWaitMaxTime) {
+	dispPtr->wmWaitMaxTime = elapsed;
+    }
+}
 
 /*
  *--------------------------------------------------------------
@@ -5525,6 +5898,7 @@ GetNetWmType(
     if (GetWindowProperty(wrapperPtr, typeAtom, maxLength, XA_ATOM,
 	    &actualType, &actualFormat, &count, &bytesAfter, &propertyValue)){
 	atoms = (Atom *) propertyValue;
+	TkCacheAtomNames(tkwin, atoms, (int) count);
 	for (n = 0; n < count; ++n) {
 	    const char *name = Tk_GetAtomName(tkwin, atoms[n]);
 
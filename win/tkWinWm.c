@@ -3673,6 +3673,7 @@ WmForgetCmd(
     if (Tk_IsTopLevel(frameWin)) {
 	Tk_UnmapWindow(frameWin);
 	winPtr->flags &= ~(TK_TOP_HIERARCHY|TK_TOP_LEVEL|TK_HAS_WRAPPER|TK_WIN_MANAGED);
+	TkGrabTreeChanged(winPtr->dispPtr);
 	Tk_MakeWindowExist((Tk_Window)winPtr->parentPtr);
 	RemapWindows(winPtr, Tk_GetHWND(winPtr->parentPtr->window));
 
@@ -4685,6 +4686,7 @@ WmManageCmd(
 	TkFocusSplit(winPtr);
 	Tk_UnmapWindow(frameWin);
 	winPtr->flags |= TK_TOP_HIERARCHY|TK_TOP_LEVEL|TK_HAS_WRAPPER|TK_WIN_MANAGED;
+	TkGrabTreeChanged(winPtr->dispPtr);
 	RemapWindows(winPtr, NULL);
 	if (wmPtr == NULL) {
 	    TkWmNewWindow(winPtr);